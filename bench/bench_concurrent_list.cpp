@@ -0,0 +1,135 @@
+#include <iostream>  // cout
+#include <chrono>    // steady_clock
+#include <mutex>     // the global lock of the baseline
+#include <thread>
+#include <vector>
+#include "../include/list.h"
+#include "../include/concurrent_list.h"
+
+using Clock = std::chrono::steady_clock;
+
+// ls::list behind one mutex: what callers had to do before concurrent_list.
+class locked_list
+{
+    public:
+        typedef ls::list<int>::iterator iterator;
+
+        iterator find( int value ) { std::lock_guard<std::mutex> guard( m_lock ); return iterator( m_list.begin() ) + value; }
+        void insert_erase_after( iterator pos, int value )
+        {
+            std::lock_guard<std::mutex> guard( m_lock );
+            ++pos;
+            m_list.erase( m_list.insert( pos, value ) );
+        }
+
+        void push_back( int value ) { std::lock_guard<std::mutex> guard( m_lock ); m_list.push_back( value ); }
+        void push_front( int value ) { std::lock_guard<std::mutex> guard( m_lock ); m_list.push_front( value ); }
+        bool pop_front()
+        {
+            std::lock_guard<std::mutex> guard( m_lock );
+            if ( m_list.empty() ) return false;
+            m_list.pop_front();
+            return true;
+        }
+        bool pop_back()
+        {
+            std::lock_guard<std::mutex> guard( m_lock );
+            if ( m_list.empty() ) return false;
+            m_list.pop_back();
+            return true;
+        }
+
+    private:
+        std::mutex m_lock;
+        ls::list<int> m_list;
+};
+
+void insert_erase_after( ls::concurrent_list<int> & seq, const ls::concurrent_list<int>::iterator & pos, int value )
+{
+    seq.erase( seq.insert_after( pos, value ) );
+}
+
+void insert_erase_after( locked_list & seq, const locked_list::iterator & pos, int value )
+{
+    seq.insert_erase_after( pos, value );
+}
+
+// Every thread inserts and erases right after its own element, far from the others.
+template < typename List >
+double spread_ns_per_op( int threads, int ops_per_thread )
+{
+    const int n = 10000;
+    List seq;
+    for ( int i = 0 ; i < n ; ++i )
+        seq.push_back( i );
+
+    auto start = Clock::now();
+    std::vector< std::thread > workers;
+    for ( int t = 0 ; t < threads ; ++t )
+    {
+        workers.emplace_back( [&seq, ops_per_thread, t, threads]
+        {
+            auto pos = seq.find( t * ( n / threads ) );
+            for ( int i = 0 ; i < ops_per_thread ; ++i )
+                insert_erase_after( seq, pos, i );
+        } );
+    }
+    for ( auto & w : workers )
+        w.join();
+
+    auto elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - start );
+    return double( elapsed.count() ) / ( double( threads ) * ops_per_thread );
+}
+
+// Every thread pushes at both ends and pops at both ends, in equal parts.
+template < typename List >
+double mixed_ns_per_op( int threads, int ops_per_thread )
+{
+    List seq;
+    for ( int i = 0 ; i < 1000 ; ++i )
+        seq.push_back( i );
+
+    auto start = Clock::now();
+    std::vector< std::thread > workers;
+    for ( int t = 0 ; t < threads ; ++t )
+    {
+        workers.emplace_back( [&seq, ops_per_thread]
+        {
+            for ( int i = 0 ; i < ops_per_thread ; ++i )
+            {
+                switch ( i % 4 )
+                {
+                    case 0: seq.push_back( i ); break;
+                    case 1: seq.push_front( i ); break;
+                    case 2: seq.pop_front(); break;
+                    default: seq.pop_back(); break;
+                }
+            }
+        } );
+    }
+    for ( auto & w : workers )
+        w.join();
+
+    auto elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - start );
+    return double( elapsed.count() ) / ( double( threads ) * ops_per_thread );
+}
+
+int main( void )
+{
+    const int ops = 200000;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << '\n';
+    std::cout << "threads\tcase\t\t\tconcurrent_list\tlist + mutex\tns/op (wall time / total ops)\n";
+
+    for ( int threads : { 1, 2, 4, 8, 16, 32 } )
+    {
+        double fine = mixed_ns_per_op< ls::concurrent_list<int> >( threads, ops );
+        double coarse = mixed_ns_per_op< locked_list >( threads, ops );
+        std::cout << threads << "\tpush+pop at the ends\t" << fine << "\t\t" << coarse << '\n';
+
+        fine = spread_ns_per_op< ls::concurrent_list<int> >( threads, ops );
+        coarse = spread_ns_per_op< locked_list >( threads, ops );
+        std::cout << threads << "\tinsert+erase inside\t" << fine << "\t\t" << coarse << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include <iostream>      // cout
+#include <algorithm>     // std::find, std::max, std::min
+#include <array>
+#include <atomic>
+#include <chrono>        // steady_clock
+#include <cstdio>        // snprintf
+#include <cstdlib>       // malloc, free, strtoll
+#include <cstring>       // strcmp
+#include <deque>
+#include <list>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../include/list.h"
+
+// Every operator new in the process is counted, so allocs/op is what reaches the system allocator.
+// ls::list draws its nodes from slabs, so it only shows up when a slab is added.
+static std::atomic<long long> g_allocs{ 0 };
+
+void * operator new( size_t bytes )
+{
+    g_allocs.fetch_add( 1, std::memory_order_relaxed );
+    if ( void * p = std::malloc( bytes ? bytes : 1 ) ) return p;
+    throw std::bad_alloc();
+}
+
+void * operator new( size_t bytes, std::align_val_t align )
+{
+    g_allocs.fetch_add( 1, std::memory_order_relaxed );
+    size_t a = size_t( align );
+    if ( void * p = std::aligned_alloc( a, ( bytes + a - 1 ) / a * a ) ) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete( void * p ) noexcept { std::free( p ); }
+void operator delete( void * p, size_t ) noexcept { std::free( p ); }
+void operator delete( void * p, std::align_val_t ) noexcept { std::free( p ); }
+void operator delete( void * p, size_t, std::align_val_t ) noexcept { std::free( p ); }
+
+using Clock = std::chrono::steady_clock;
+
+// An element of Bytes bytes: an int key and padding.
+template < size_t Bytes >
+struct payload
+{
+    int key;
+    std::array< char, Bytes - sizeof( int ) > pad;
+
+    payload( int k = 0 ) : key( k ), pad() { /*empty*/ }
+    bool operator==( const payload & rhs ) const { return key == rhs.key; }
+};
+
+// What one measurement produced.
+struct sample
+{
+    double ns_per_op;
+    double allocs_per_op;
+};
+
+// Times body(), which does ops operations, repeated until about min_ops operations were done
+// or max_ns went by, setup included, whichever comes first. setup() runs untimed before every repetition.
+template < typename Setup, typename Body >
+sample measure( size_t ops, Setup setup, Body body )
+{
+    const size_t min_ops = 1000000;
+    const long long max_ns = 200000000;
+    size_t reps = std::max< size_t >( 1, min_ops / std::max< size_t >( ops, 1 ) );
+    long long ns = 0;
+    long long allocs = 0;
+
+    auto first = Clock::now();
+    size_t r = 0;
+    for ( ; r < reps and ( r == 0 or std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - first ).count() < max_ns ); ++r )
+    {
+        setup();
+        long long before = g_allocs.load( std::memory_order_relaxed );
+        auto start = Clock::now();
+        body();
+        ns += std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - start ).count();
+        allocs += g_allocs.load( std::memory_order_relaxed ) - before;
+    }
+
+    double total = double( r ) * double( ops );
+    return sample{ ns / total, allocs / total };
+}
+
+// Container specific bits: ls::list has its own find and no iterator_category.
+template < typename C >
+struct traits;
+
+template < typename V > struct traits< std::list<V> >
+{
+    static const char * name() { return "std::list"; }
+    static bool random_access() { return false; }
+
+    template < typename C >
+    static bool contains( const C & c, const V & value ) { return std::find( c.begin(), c.end(), value ) != c.end(); }
+
+    template < typename C >
+    static typename C::iterator middle( C & c ) { return std::next( c.begin(), c.size() / 2 ); }
+};
+
+template < typename V > struct traits< ls::list<V> > : traits< std::list<V> >
+{
+    static const char * name() { return "ls::list"; }
+    static bool contains( const ls::list<V> & c, const V & value ) { return c.find( value ) != c.cend(); }
+    static typename ls::list<V>::iterator middle( ls::list<V> & c ) { return c.advance_to( c.size() / 2 ); }
+};
+
+template < typename V > struct traits< std::deque<V> > : traits< std::list<V> >
+{
+    static const char * name() { return "std::deque"; }
+    static bool random_access() { return true; }
+};
+
+template < typename V > struct traits< std::vector<V> > : traits< std::list<V> >
+{
+    static const char * name() { return "std::vector"; }
+    static bool random_access() { return true; }
+};
+
+template < typename C >
+void fill( C & c, size_t n )
+{
+    for ( size_t i = 0; i < n; ++i ) c.push_back( int( i ) );
+}
+
+bool g_first = true;
+
+void emit( const char * container, size_t bytes, size_t n, const char * op, sample s )
+{
+    std::cout << ( g_first ? "\n" : ",\n" );
+    g_first = false;
+
+    char line[ 256 ];
+    std::snprintf( line, sizeof( line ),
+        "    { \"container\": \"%s\", \"payload\": %zu, \"size\": %zu, \"op\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f }",
+        container, bytes, n, op, s.ns_per_op, s.allocs_per_op );
+    std::cout << line << std::flush;
+}
+
+// Operations that shift elements (vector push_front, middle insert and erase on arrays) are
+// capped to this many bytes moved per measurement, so the large sizes stay in seconds.
+const double shift_budget = 2e9;
+
+template < typename C, size_t Bytes >
+void run( size_t n )
+{
+    using V = payload< Bytes >;
+    using T = traits< C >;
+    const char * name = T::name();
+
+    // Built from empty; the old contents are freed outside the timing.
+    {
+        C c;
+        emit( name, Bytes, n, "push_back", measure( n, [&c]{ c = C(); }, [&c, n]{ fill( c, n ); } ) );
+
+        if ( not std::is_same< C, std::vector<V> >::value or double( n ) * n * Bytes / 2 <= shift_budget )
+        {
+            emit( name, Bytes, n, "push_front", measure( n, [&c]{ c = C(); }, [&c, n]{
+                for ( size_t i = 0; i < n; ++i ) c.insert( c.begin(), V( int( i ) ) );
+            } ) );
+        }
+    }
+
+    // A batch of inserts, then of erases, at the middle of a container of about n elements.
+    size_t k = std::min< size_t >( 1000, n );
+    if ( T::random_access() ) k = std::max< size_t >( 1, std::min< double >( k, shift_budget / ( double( n ) * Bytes ) ) );
+    {
+        C c;
+        typename C::iterator pos;
+        emit( name, Bytes, n, "insert_middle", measure( k, [&c, &pos, n]{ c = C(); fill( c, n ); pos = T::middle( c ); }, [&c, &pos, k]{
+            for ( size_t i = 0; i < k; ++i ) pos = c.insert( pos, V( -1 ) );
+        } ) );
+    }
+    {
+        // The middle of n + k elements has at least k after it.
+        C c;
+        typename C::iterator pos;
+        emit( name, Bytes, n, "erase_middle", measure( k, [&c, &pos, n, k]{ c = C(); fill( c, n + k ); pos = T::middle( c ); }, [&c, &pos, k]{
+            for ( size_t i = 0; i < k; ++i ) pos = c.erase( pos );
+        } ) );
+    }
+
+    C c;
+    fill( c, n );
+
+    // The last element: a full scan. ns/op is per element visited.
+    V last( int( n - 1 ) );
+    bool found = true;
+    emit( name, Bytes, n, "find", measure( n, []{}, [&]{ found = found and T::contains( c, last ); } ) );
+
+    long long sum = 0;
+    emit( name, Bytes, n, "iterate", measure( n, []{}, [&]{
+        for ( auto i = c.begin(); i != c.end(); ++i ) sum += ( *i ).key;
+    } ) );
+
+    emit( name, Bytes, n, "copy", measure( n, []{}, [&]{ C copy( c ); sum += copy.size(); } ) );
+
+    C other( c );
+    bool equal = true;
+    emit( name, Bytes, n, "equal", measure( n, []{}, [&]{ equal = equal and c == other; } ) );
+
+    C * victim = nullptr;
+    emit( name, Bytes, n, "destroy", measure( n, [&]{ victim = new C(); fill( *victim, n ); }, [&]{ delete victim; } ) );
+
+    if ( not found or not equal or sum == 42 ) std::cerr << "unexpected result\n";
+}
+
+template < size_t Bytes >
+void run_payload( const std::vector< size_t > & sizes )
+{
+    for ( size_t n : sizes )
+    {
+        run< ls::list< payload< Bytes > >, Bytes >( n );
+        run< std::list< payload< Bytes > >, Bytes >( n );
+        run< std::deque< payload< Bytes > >, Bytes >( n );
+        run< std::vector< payload< Bytes > >, Bytes >( n );
+    }
+}
+
+// Usage: run_bench_containers [--max-size N]   (default 1000000; up to 10000000 needs several GB)
+int main( int argc, char * argv[] )
+{
+    size_t max_size = 1000000;
+    for ( int i = 1; i + 1 < argc; ++i )
+    {
+        if ( std::strcmp( argv[ i ], "--max-size" ) == 0 ) max_size = size_t( std::strtoll( argv[ i + 1 ], nullptr, 10 ) );
+    }
+
+    std::vector< size_t > sizes;
+    for ( size_t n = 100; n <= max_size and n <= 10000000; n *= 10 ) sizes.push_back( n );
+
+    std::cout << "{\n  \"benchmark\": \"containers\",\n  \"unit\": \"ns/op\",\n  \"results\": [";
+    run_payload< 4 >( sizes );
+    run_payload< 16 >( sizes );
+    run_payload< 64 >( sizes );
+    run_payload< 256 >( sizes );
+    std::cout << "\n  ]\n}\n";
+
+    return 0;
+}
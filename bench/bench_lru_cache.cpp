@@ -0,0 +1,96 @@
+#include <iostream>      // cout
+#include <chrono>        // steady_clock
+#include <list>          // std::list, for the hand-made cache
+#include <unordered_map>
+#include <vector>
+#include "../include/lru_cache.h"
+
+using Clock = std::chrono::steady_clock;
+
+// The usual recency list plus hash map, glued together by hand.
+class glued_cache
+{
+    public:
+        explicit glued_cache( size_t capacity ) : m_capacity( capacity ) { /*empty*/ }
+
+        long long * get( int key )
+        {
+            auto i = m_index.find( key );
+            if ( i == m_index.end() ) return nullptr;
+            m_list.splice( m_list.begin(), m_list, i->second );
+            return &i->second->second;
+        }
+
+        void put( int key, long long value )
+        {
+            auto i = m_index.find( key );
+            if ( i != m_index.end() )
+            {
+                i->second->second = value;
+                m_list.splice( m_list.begin(), m_list, i->second );
+                return;
+            }
+            m_list.emplace_front( key, value );
+            m_index[ key ] = m_list.begin();
+            if ( m_list.size() > m_capacity )
+            {
+                m_index.erase( m_list.back().first );
+                m_list.pop_back();
+            }
+        }
+
+    private:
+        size_t m_capacity;
+        std::list< std::pair< int, long long > > m_list;
+        std::unordered_map< int, std::list< std::pair< int, long long > >::iterator > m_index;
+};
+
+// Keys skewed towards small values, so the hit ratio depends on the capacity.
+std::vector<int> make_keys( size_t n, int universe )
+{
+    std::vector<int> keys( n );
+    unsigned seed = 3;
+    for ( auto & k : keys )
+    {
+        seed = seed * 1103515245u + 12345u;
+        unsigned a = ( seed >> 8 ) % unsigned( universe );
+        seed = seed * 1103515245u + 12345u;
+        unsigned b = ( seed >> 8 ) % unsigned( universe );
+        k = int( a < b ? a : b );
+    }
+    return keys;
+}
+
+// Get, and put on a miss: the read-through pattern.
+template < typename Cache >
+double ns_per_op( Cache & cache, const std::vector<int> & keys )
+{
+    auto start = Clock::now();
+    for ( int k : keys )
+    {
+        if ( cache.get( k ) == nullptr )
+            cache.put( k, k );
+    }
+    auto elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - start );
+    return double( elapsed.count() ) / keys.size();
+}
+
+int main( void )
+{
+    const size_t ops = 5000000;
+    const int universe = 1000000;
+    auto keys = make_keys( ops, universe );
+
+    std::cout << "capacity\thit ratio\tls::lru_cache\tlist + map\tns/op\n";
+    for ( size_t capacity : { size_t( 1000 ), size_t( 100000 ), size_t( 500000 ) } )
+    {
+        ls::lru_cache< int, long long > cache( capacity );
+        glued_cache glued( capacity );
+        double ours = ns_per_op( cache, keys );
+        double theirs = ns_per_op( glued, keys );
+        double ratio = double( cache.stats().hits ) / ( cache.stats().hits + cache.stats().misses );
+        std::cout << capacity << "\t\t" << ratio << "\t\t" << ours << "\t\t" << theirs << '\n';
+    }
+
+    return 0;
+}
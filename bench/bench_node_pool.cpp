@@ -0,0 +1,96 @@
+#include <iostream>  // cout
+#include <chrono>    // steady_clock
+#include <list>      // std::list, one operator new per node
+#include <string>
+#include "../include/list.h"
+
+using Clock = std::chrono::steady_clock;
+
+template < typename F >
+double time_ns_per_op( F f, size_t ops )
+{
+    auto start = Clock::now();
+    f();
+    auto elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - start );
+    return double( elapsed.count() ) / ops;
+}
+
+// Fill with push_back, then drain with pop_front: the append-heavy ingest pattern.
+template < typename List >
+void append_drain( size_t n, int rounds )
+{
+    List seq;
+    for ( int r = 0 ; r < rounds ; ++r )
+    {
+        for ( size_t i = 0 ; i < n ; ++i )
+            seq.push_back( int( i ) );
+        while ( not seq.empty() )
+            seq.pop_front();
+    }
+}
+
+// Full traversal after the list was built, to show the effect of node locality.
+template < typename List >
+long long build_and_sum( size_t n )
+{
+    List seq;
+    for ( size_t i = 0 ; i < n ; ++i )
+        seq.push_back( int( i ) );
+
+    long long sum = 0;
+    for ( auto e : seq )
+        sum += e;
+    return sum;
+}
+
+struct Payload { void *prev; void *next; int data; };
+
+// The same list, with one operator new per node.
+using heap_list = ls::list< int, std::allocator<int> >;
+
+int main( void )
+{
+    const int rounds = 20;
+    std::cout << "size\tcase\t\t\tls::list (pool)\tls::list (new)\tstd::list\tns/op\n";
+
+    for ( size_t n : { size_t( 1000 ), size_t( 100000 ), size_t( 1000000 ) } )
+    {
+        double pool = time_ns_per_op( [&]{ append_drain< ls::list<int> >( n, rounds ); }, n * rounds );
+        double heap = time_ns_per_op( [&]{ append_drain< heap_list >( n, rounds ); }, n * rounds );
+        double stdl = time_ns_per_op( [&]{ append_drain< std::list<int> >( n, rounds ); }, n * rounds );
+        std::cout << n << "\tpush_back+pop_front\t" << pool << "\t\t" << heap << "\t\t" << stdl << '\n';
+
+        volatile long long sink = 0;
+        pool = time_ns_per_op( [&]{ sink = build_and_sum< ls::list<int> >( n ); }, n );
+        heap = time_ns_per_op( [&]{ sink = build_and_sum< heap_list >( n ); }, n );
+        stdl = time_ns_per_op( [&]{ sink = build_and_sum< std::list<int> >( n ); }, n );
+        std::cout << n << "\tbuild+iterate\t\t" << pool << "\t\t" << heap << "\t\t" << stdl << '\n';
+    }
+
+    // The raw allocator against operator new for the same slot size.
+    const size_t n = 1000000;
+    static Payload *slots[ 1000000 ];
+    using pool_type = ls::node_pool< sizeof( Payload ), alignof( Payload ) >;
+
+    double pool = time_ns_per_op( [&]{
+        for ( int r = 0 ; r < rounds ; ++r )
+        {
+            for ( size_t i = 0 ; i < n ; ++i )
+                slots[ i ] = static_cast< Payload* >( pool_type::local().allocate() );
+            for ( size_t i = 0 ; i < n ; ++i )
+                pool_type::local().deallocate( slots[ i ] );
+        }
+    }, n * rounds );
+    double heap = time_ns_per_op( [&]{
+        for ( int r = 0 ; r < rounds ; ++r )
+        {
+            for ( size_t i = 0 ; i < n ; ++i )
+                slots[ i ] = new Payload;
+            for ( size_t i = 0 ; i < n ; ++i )
+                delete slots[ i ];
+        }
+    }, n * rounds );
+    std::cout << n << "\tallocate+deallocate\t" << pool << "\t\t" << heap << '\n';
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <iostream>  // cout
+#include <algorithm> // std::sort
+#include <chrono>    // steady_clock
+#include <thread>
+#include <vector>
+#include "../include/list_parallel.h"
+
+using Clock = std::chrono::steady_clock;
+
+template < typename F >
+double time_ms( F f )
+{
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration< double, std::milli >( Clock::now() - start ).count();
+}
+
+ls::list<int> shuffled( int n )
+{
+    ls::list<int> seq;
+    unsigned seed = 1;
+    for ( int i = 0 ; i < n ; ++i )
+    {
+        seed = seed * 1103515245u + 12345u;
+        seq.push_back( int( seed >> 4 ) );
+    }
+    return seq;
+}
+
+int main( void )
+{
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << '\n';
+    std::cout << "size\tsort()\t\tparallel::sort()\tvector round trip\tms\n";
+
+    for ( int n : { 100000, 1000000, 10000000 } )
+    {
+        ls::list<int> a = shuffled( n );
+        ls::list<int> b = shuffled( n );
+        ls::list<int> c = shuffled( n );
+
+        double serial = time_ms( [&]{ a.sort(); } );
+        double parallel = time_ms( [&]{ ls::parallel::sort( b ); } );
+        // What callers did before: copy out, sort the array, rebuild the list.
+        double vector = time_ms( [&]{
+            std::vector<int> items;
+            items.reserve( c.size() );
+            for ( auto it = c.cbegin() ; it != c.cend() ; ++it )
+                items.push_back( *it );
+            std::sort( items.begin(), items.end() );
+            c.assign( items.begin(), items.end() );
+        } );
+
+        std::cout << n << '\t' << serial << "\t\t" << parallel << "\t\t" << vector << '\n';
+    }
+
+    return 0;
+}
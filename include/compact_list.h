@@ -0,0 +1,700 @@
+#ifndef COMPACT_LIST_H
+#define COMPACT_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "node_pool.h"
+
+namespace ls{
+template<typename T, typename Allocator = pool_allocator<T> >
+
+	/* <! Double linked list whose nodes live side by side in one growable array and link to each
+		other by 32-bit index instead of by pointer. A node costs two uint32_t next to its value, with
+		no per-node allocation, and erased nodes are chained through a free list and reused first.
+		Slot 0 is the sentinel. Since a node keeps its index for as long as it is in the list, a handle
+		stays valid across growth, copies and moves; iterators refer to the list object and do not
+		survive a move. For trivially copyable T a copy is a single memcpy of the array.
+	*/
+	class compact_list
+	{
+		private:
+			typedef std::uint32_t index_type;
+
+			/* <! Links of one node, and room for its value. Free slots link through next only. */
+			struct Slot{
+				index_type prev; //<! Index of the previous node in the list.
+				index_type next; //<! Index of the next node in the list, or the next free slot.
+				alignas(T) unsigned char storage[ sizeof(T) ]; //<! Data field; alive only for linked nodes.
+			};
+
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Slot> slot_allocator_type;
+			typedef std::allocator_traits<slot_allocator_type> slot_traits;
+
+			/* <! Most slots an array can hold, the sentinel included. */
+			static constexpr index_type max_slots = index_type(-1);
+
+		public:
+			typedef Allocator allocator_type;
+
+			/* <! Stable name of a node: its index in the array. Valid until the node is erased. */
+			struct handle{
+				index_type index = 0;
+
+				bool operator==( const handle & rhs ) const { return index == rhs.index; }
+				bool operator!=( const handle & rhs ) const { return index != rhs.index; }
+			};
+
+			/* <! A simple const_iterator class: the list and an index into it. */
+			class const_iterator{
+				public:
+					typedef const T& const_reference;
+					typedef const T* const_pointer;
+					typedef std::ptrdiff_t difference_type;
+
+					const_iterator() = default;
+
+					const_reference operator*() const { return *owner->slot(index); }
+					const_pointer operator->() const { return owner->slot(index); }
+
+					const_iterator & operator++(){ index = owner->m_slots[index].next; return *this; }
+					const_iterator operator++(int){ const_iterator temp(*this); ++(*this); return temp; }
+					const_iterator & operator--(){ index = owner->m_slots[index].prev; return *this; }
+					const_iterator operator--(int){ const_iterator temp(*this); --(*this); return temp; }
+
+					bool operator==(const const_iterator &rhs) const { return index == rhs.index; }
+					bool operator!=(const const_iterator &rhs) const { return index != rhs.index; }
+
+				protected:
+					const compact_list *owner = nullptr;
+					index_type index = 0;
+					const_iterator(const compact_list *l, index_type i) : owner(l), index(i){ /*empty*/ }
+
+					friend class compact_list;
+			};
+
+			class iterator : public const_iterator{
+				public:
+					typedef T& reference;
+					typedef T* pointer;
+
+					iterator() : const_iterator() { /*empty*/ }
+
+					reference operator*() const { return *this->owner->slot(this->index); }
+					pointer operator->() const { return this->owner->slot(this->index); }
+
+					iterator & operator++(){ const_iterator::operator++(); return *this; }
+					iterator operator++(int){ iterator temp(*this); const_iterator::operator++(); return temp; }
+					iterator & operator--(){ const_iterator::operator--(); return *this; }
+					iterator operator--(int){ iterator temp(*this); const_iterator::operator--(); return temp; }
+
+				protected:
+					iterator(const compact_list *l, index_type i) : const_iterator(l, i){ /*empty*/ }
+
+					friend class compact_list;
+			};
+
+			// [I] SPECIAL MEMBERS
+			compact_list() : compact_list( Allocator() ){ /*empty*/ }
+
+			/* <! Constructs an empty list that allocates through alloc. Nothing is allocated until the first insertion. */
+			explicit compact_list( const Allocator & alloc ) : m_alloc(alloc){ /*empty*/ }
+
+			/* <! Constructs the list with the contents of the range [first,last). */
+			template<typename InputIt>
+			compact_list( InputIt first, InputIt last, const Allocator & alloc = Allocator() );
+
+			/* <! Constructs the list with the contents of the initializer list ilist. */
+			compact_list( std::initializer_list<T> ilist, const Allocator & alloc = Allocator() );
+
+			/* <! Copy constructs. Every node keeps its index, so handles into other name the same elements in the copy. */
+			compact_list( const compact_list & other );
+
+			/* <! Move constructs. Takes the array of other in O(1). */
+			compact_list( compact_list && other ) noexcept;
+
+			~compact_list();
+
+			/* <! Copy assigns. Nodes keep their indices, as in the copy constructor; the new array comes
+				from this list's allocator, or from other's when the allocator propagates.
+			*/
+			compact_list & operator= ( const compact_list & other );
+
+			/* <! Move assigns. Takes the array of other when the allocator propagates or compares equal,
+				otherwise moves the elements one by one into an array of this list's allocator.
+			*/
+			compact_list & operator= ( compact_list && other ) noexcept( slot_traits::propagate_on_container_move_assignment::value || slot_traits::is_always_equal::value );
+			compact_list & operator= ( std::initializer_list<T> ilist );
+
+			allocator_type get_allocator() const { return allocator_type(m_alloc); }
+
+			//[II] ITERATORS
+			iterator begin(){ return iterator(this, first()); }
+			const_iterator begin() const { return cbegin(); }
+			const_iterator cbegin() const { return const_iterator(this, first()); }
+			iterator end(){ return iterator(this, 0); }
+			const_iterator end() const { return cend(); }
+			const_iterator cend() const { return const_iterator(this, 0); }
+
+			//[III] CAPACITY
+			int size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+
+			/* <! Number of elements the array holds before it grows again. */
+			int capacity() const { return m_capacity == 0 ? 0 : int( m_capacity - 1 ); }
+
+			/* <! Grows the array to hold count elements, without changing any index. */
+			void reserve( int count );
+
+			//[IV] MODIFIERS
+
+			/* <! Removes every element. The array is kept for reuse. */
+			void clear();
+
+			T & front(){ return *slot(first()); }
+			const T & front() const { return *slot(first()); }
+			T & back(){ return *slot(m_slots[0].prev); }
+			const T & back() const { return *slot(m_slots[0].prev); }
+
+			void push_front( const T & value ){ emplace(cbegin(), value); }
+			void push_front( T && value ){ emplace(cbegin(), std::move(value)); }
+			void push_back( const T & value ){ emplace(cend(), value); }
+			void push_back( T && value ){ emplace(cend(), std::move(value)); }
+
+			template<typename... Args>
+			T & emplace_front( Args &&... args ){ return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+			template<typename... Args>
+			T & emplace_back( Args &&... args ){ return *emplace(cend(), std::forward<Args>(args)...); }
+
+			void pop_front(){ erase(cbegin()); }
+			void pop_back(){ erase(--cend()); }
+
+			/* <! Replaces every element with a copy of value. */
+			void assign( const T & value );
+
+			template<typename InItr>
+			void assign( InItr first, InItr last );
+
+			void assign( std::initializer_list<T> ilist ){ assign(ilist.begin(), ilist.end()); }
+
+			//[IV-a] MODIFIERS WITH ITERATORS
+
+			/* <! Builds a value in place before pos, in a free slot if there is one.
+				Growing the array keeps every index, so iterators and handles stay valid.
+				@return The iterator to the new value.
+			*/
+			template<typename... Args>
+			iterator emplace( const_iterator pos, Args &&... args );
+
+			iterator insert( const_iterator pos, const T & value ){ return emplace(pos, value); }
+			iterator insert( const_iterator pos, T && value ){ return emplace(pos, std::move(value)); }
+
+			/* <! Insert elements from the range [first; last) before pos.
+				@return The iterator to the first element added, or pos if the range is empty.
+			*/
+			template<typename InItr>
+			iterator insert( const_iterator pos, InItr first, InItr last );
+
+			iterator insert( const_iterator pos, std::initializer_list<T> ilist ){ return insert(pos, ilist.begin(), ilist.end()); }
+
+			/* <! Removes the object at pos; its slot goes to the free list.
+				@return Iterator to the element after pos.
+			*/
+			iterator erase( const_iterator pos );
+
+			/* <! Removes the objects on the range [first; last).
+				@return Iterator to last.
+			*/
+			iterator erase( const_iterator first, const_iterator last );
+
+			/* <! Search for a value in the list.
+				@return The position of the value, or end() if it is not in the list.
+			*/
+			const_iterator find( const T & value ) const;
+
+			//[V] HANDLES
+
+			/* <! Returns the handle of the element at pos. */
+			handle handle_of( const_iterator pos ) const { return handle{ pos.index }; }
+
+			/* <! Returns the iterator to the element named by h. O(1). */
+			iterator iterator_to( handle h ){ return iterator(this, h.index); }
+			const_iterator iterator_to( handle h ) const { return const_iterator(this, h.index); }
+
+			/* <! Returns the element named by h. O(1). */
+			T & operator[]( handle h ){ return *slot(h.index); }
+			const T & operator[]( handle h ) const { return *slot(h.index); }
+
+			//[VI] OPERATIONS
+
+			/* <! Moves the element at it before pos, relinking indices only. */
+			void splice( const_iterator pos, const_iterator it );
+
+			/* <! Moves the elements in [first; last) before pos, relinking indices only. pos must be outside the range. */
+			void splice( const_iterator pos, const_iterator first, const_iterator last );
+
+			/* <! Reverses the order of the elements by swapping the links of every node. */
+			void reverse();
+
+			bool operator==( const compact_list & rhs ) const;
+			bool operator!=( const compact_list & rhs ) const { return !(*this == rhs); }
+
+		private:
+			/* <! Address of the value of the node at index i, which must be linked. */
+			T * slot( index_type i ) const {
+				return std::launder( reinterpret_cast<T*>( m_slots[i].storage ) );
+			}
+
+			/* <! Raw storage of node s, where a value is about to be constructed. */
+			static T * storage( Slot & s ){ return reinterpret_cast<T*>( s.storage ); }
+
+			/* <! Index of the first node; 0 when the array is not allocated yet. */
+			index_type first() const { return m_slots == nullptr ? 0 : m_slots[0].next; }
+
+			/* <! Moves the array to a new one of count slots, keeping every index. */
+			void grow( index_type count );
+
+			/* <! Takes a slot from the free list, or the next unused one, growing the array if needed. */
+			index_type take_slot();
+
+			/* <! Builds a value in a new node and links it before node pos. */
+			template<typename... Args>
+			iterator build( index_type pos, Args &&... args );
+
+			/* <! Links the unlinked node i before node pos. */
+			void link( index_type i, index_type pos );
+
+			/* <! Unlinks node i, destroys its value and puts its slot on the free list. */
+			void release( index_type i );
+
+			/* <! Destroys every value and frees the array. */
+			void destroy();
+
+			/* <! Takes the array of other, which is left empty. This list must hold no array, and its
+				allocator must be able to free other's.
+			*/
+			void steal( compact_list & other ) noexcept;
+
+			/* <! Copies other into a new array of m_alloc, every node at its index. This list must hold no array. */
+			void copy_slots( const compact_list & other );
+
+			slot_allocator_type m_alloc;
+			Slot *m_slots = nullptr;   //<! m_slots[0] is the sentinel: its next is the first node, its prev the last.
+			index_type m_capacity = 0; //<! Slots in the array.
+			index_type m_used = 0;     //<! Slots handed out so far; the ones past it were never used.
+			index_type m_free = 0;     //<! First free slot, or 0 when there is none.
+			int m_size = 0;
+	};
+
+	//=======================================================================================
+
+	//SPECIAL MEMBERS
+	template<typename T, typename Allocator>
+	template<typename InputIt>
+	compact_list<T,Allocator>::compact_list( InputIt first, InputIt last, const Allocator & alloc ) : m_alloc(alloc){
+		try{
+			for(; first != last; ++first){
+				emplace_back(*first);
+			}
+		}catch(...){
+			destroy();
+			throw;
+		}
+	}
+
+	template<typename T, typename Allocator>
+	compact_list<T,Allocator>::compact_list( std::initializer_list<T> ilist, const Allocator & alloc ) : m_alloc(alloc){
+		reserve( int( ilist.size() ) );
+		try{
+			for(const T &value : ilist){
+				emplace_back(value);
+			}
+		}catch(...){
+			destroy();
+			throw;
+		}
+	}
+
+	template<typename T, typename Allocator>
+	compact_list<T,Allocator>::compact_list( const compact_list & other ) :
+		m_alloc( slot_traits::select_on_container_copy_construction(other.m_alloc) ){
+		copy_slots(other);
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::copy_slots( const compact_list & other ){
+		if(other.m_slots == nullptr) return;
+
+		m_slots = slot_traits::allocate(m_alloc, other.m_used);
+		m_capacity = other.m_used;
+
+		if constexpr(std::is_trivially_copyable<T>::value){
+			std::memcpy( static_cast<void*>(m_slots), other.m_slots, other.m_used * sizeof(Slot) );
+		}else{
+			// Links first, then the values of the linked nodes at the same indices.
+			for(index_type i = 0; i < other.m_used; ++i){
+				m_slots[i].prev = other.m_slots[i].prev;
+				m_slots[i].next = other.m_slots[i].next;
+			}
+
+			index_type i = other.m_slots[0].next;
+			try{
+				for(; i != 0; i = other.m_slots[i].next){
+					slot_traits::construct(m_alloc, storage(m_slots[i]), *other.slot(i));
+				}
+			}catch(...){
+				for(index_type j = other.m_slots[0].next; j != i; j = other.m_slots[j].next){
+					slot_traits::destroy(m_alloc, slot(j));
+				}
+				slot_traits::deallocate(m_alloc, m_slots, m_capacity);
+				throw;
+			}
+		}
+
+		m_used = other.m_used;
+		m_free = other.m_free;
+		m_size = other.m_size;
+	}
+
+	template<typename T, typename Allocator>
+	compact_list<T,Allocator>::compact_list( compact_list && other ) noexcept : m_alloc(other.m_alloc){
+		steal(other);
+	}
+
+	template<typename T, typename Allocator>
+	compact_list<T,Allocator>::~compact_list(){
+		destroy();
+	}
+
+	template<typename T, typename Allocator>
+	compact_list<T,Allocator> & compact_list<T,Allocator>::operator= ( const compact_list & other ){
+		if(this == &other) return *this;
+
+		// Built with the allocator this list ends up with, so the array can change hands.
+		compact_list temp( Allocator( slot_traits::propagate_on_container_copy_assignment::value ? other.m_alloc : m_alloc ) );
+		temp.copy_slots(other);
+		destroy();
+		if constexpr(slot_traits::propagate_on_container_copy_assignment::value){
+			m_alloc = other.m_alloc;
+		}
+		steal(temp);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	compact_list<T,Allocator> & compact_list<T,Allocator>::operator= ( compact_list && other )
+		noexcept( slot_traits::propagate_on_container_move_assignment::value || slot_traits::is_always_equal::value ){
+		if(this == &other) return *this;
+
+		if(slot_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc){
+			destroy();
+			if constexpr(slot_traits::propagate_on_container_move_assignment::value){
+				m_alloc = other.m_alloc;
+			}
+			steal(other);
+		}else{
+			// The array cannot change hands between unrelated allocators.
+			clear();
+			reserve(other.size());
+			for(auto i(other.begin()); i != other.end(); ++i){
+				emplace_back(std::move(*i));
+			}
+			other.clear();
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	compact_list<T,Allocator> & compact_list<T,Allocator>::operator= ( std::initializer_list<T> ilist ){
+		assign(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	//=======================================================================================
+
+	//SLOTS
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::grow( index_type count ){
+		Slot *temp = slot_traits::allocate(m_alloc, count);
+
+		if(m_slots == nullptr){
+			temp[0].prev = 0;
+			temp[0].next = 0;
+			m_used = 1;
+		}else if constexpr(std::is_trivially_copyable<T>::value){
+			std::memcpy( static_cast<void*>(temp), m_slots, m_used * sizeof(Slot) );
+		}else{
+			for(index_type i = 0; i < m_used; ++i){
+				temp[i].prev = m_slots[i].prev;
+				temp[i].next = m_slots[i].next;
+			}
+
+			index_type i = m_slots[0].next;
+			try{
+				for(; i != 0; i = m_slots[i].next){
+					slot_traits::construct( m_alloc, storage(temp[i]), std::move_if_noexcept(*slot(i)) );
+				}
+			}catch(...){
+				for(index_type j = m_slots[0].next; j != i; j = m_slots[j].next){
+					slot_traits::destroy( m_alloc, std::launder( reinterpret_cast<T*>( temp[j].storage ) ) );
+				}
+				slot_traits::deallocate(m_alloc, temp, count);
+				throw;
+			}
+
+			for(i = m_slots[0].next; i != 0; i = m_slots[i].next){
+				slot_traits::destroy(m_alloc, slot(i));
+			}
+		}
+
+		if(m_slots != nullptr){
+			slot_traits::deallocate(m_alloc, m_slots, m_capacity);
+		}
+		m_slots = temp;
+		m_capacity = count;
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::reserve( int count ){
+		if(count < 0 || index_type(count) >= max_slots) throw std::length_error("compact_list::reserve");
+
+		index_type wanted = index_type(count) + 1;
+		if(wanted > m_capacity) grow(wanted);
+	}
+
+	template<typename T, typename Allocator>
+	typename compact_list<T,Allocator>::index_type compact_list<T,Allocator>::take_slot(){
+		if(m_free != 0){
+			index_type i = m_free;
+			m_free = m_slots[i].next;
+			return i;
+		}
+
+		if(m_used == m_capacity){
+			if(m_capacity == max_slots) throw std::length_error("compact_list: too many elements");
+
+			index_type count = m_capacity < 8 ? 16 : ( m_capacity > max_slots / 2 ? max_slots : m_capacity * 2 );
+			grow(count);
+		}
+		return m_used++;
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::link( index_type i, index_type pos ){
+		index_type before = m_slots[pos].prev;
+
+		m_slots[i].prev = before;
+		m_slots[i].next = pos;
+		m_slots[before].next = i;
+		m_slots[pos].prev = i;
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::release( index_type i ){
+		Slot &s = m_slots[i];
+		m_slots[s.prev].next = s.next;
+		m_slots[s.next].prev = s.prev;
+
+		slot_traits::destroy(m_alloc, slot(i));
+		s.next = m_free;
+		m_free = i;
+		m_size--;
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::destroy(){
+		if(m_slots == nullptr) return;
+
+		clear();
+		slot_traits::deallocate(m_alloc, m_slots, m_capacity);
+		m_slots = nullptr;
+		m_capacity = 0;
+		m_used = 0;
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::steal( compact_list & other ) noexcept{
+		m_slots = other.m_slots;
+		m_capacity = other.m_capacity;
+		m_used = other.m_used;
+		m_free = other.m_free;
+		m_size = other.m_size;
+
+		other.m_slots = nullptr;
+		other.m_capacity = 0;
+		other.m_used = 0;
+		other.m_free = 0;
+		other.m_size = 0;
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::clear(){
+		if(m_slots == nullptr) return;
+
+		if constexpr(!std::is_trivially_destructible<T>::value){
+			for(index_type i = m_slots[0].next; i != 0; i = m_slots[i].next){
+				slot_traits::destroy(m_alloc, slot(i));
+			}
+		}
+
+		// Every slot is unused again, so the free list starts over.
+		m_slots[0].prev = 0;
+		m_slots[0].next = 0;
+		m_used = 1;
+		m_free = 0;
+		m_size = 0;
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::assign( const T & value ){
+		for(auto i(begin()); i != end(); ++i){
+			*i = value;
+		}
+	}
+
+	template<typename T, typename Allocator>
+	template<typename InItr>
+	void compact_list<T,Allocator>::assign( InItr first, InItr last ){
+		auto i(begin());
+
+		for(; i != end() && first != last; ++i, ++first){
+			*i = *first;
+		}
+
+		if(first == last){
+			erase(i, end());
+		}else{
+			insert(cend(), first, last);
+		}
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	typename compact_list<T,Allocator>::iterator compact_list<T,Allocator>::emplace( const_iterator pos, Args &&... args ){
+		if(m_free == 0 && m_used == m_capacity && m_slots != nullptr){
+			// args may refer to an element, which growing the array would move: build the value first.
+			T value(std::forward<Args>(args)...);
+			return build(pos.index, std::move(value));
+		}
+		return build(pos.index, std::forward<Args>(args)...);
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	typename compact_list<T,Allocator>::iterator compact_list<T,Allocator>::build( index_type pos, Args &&... args ){
+		index_type i = take_slot();
+
+		try{
+			slot_traits::construct(m_alloc, storage(m_slots[i]), std::forward<Args>(args)...);
+		}catch(...){
+			m_slots[i].next = m_free;
+			m_free = i;
+			throw;
+		}
+
+		link(i, pos);
+		m_size++;
+
+		return iterator(this, i);
+	}
+
+	template<typename T, typename Allocator>
+	template<typename InItr>
+	typename compact_list<T,Allocator>::iterator compact_list<T,Allocator>::insert( const_iterator pos, InItr first, InItr last ){
+		if(first == last) return iterator(this, pos.index);
+
+		iterator temp = emplace(pos, *first);
+		for(++first; first != last; ++first){
+			emplace(pos, *first);
+		}
+		return temp;
+	}
+
+	template<typename T, typename Allocator>
+	typename compact_list<T,Allocator>::iterator compact_list<T,Allocator>::erase( const_iterator pos ){
+		if(pos.index == 0) return end();
+
+		index_type next = m_slots[pos.index].next;
+		release(pos.index);
+		return iterator(this, next);
+	}
+
+	template<typename T, typename Allocator>
+	typename compact_list<T,Allocator>::iterator compact_list<T,Allocator>::erase( const_iterator first, const_iterator last ){
+		while(first != last){
+			first = erase(first);
+		}
+		return iterator(this, last.index);
+	}
+
+	template<typename T, typename Allocator>
+	typename compact_list<T,Allocator>::const_iterator compact_list<T,Allocator>::find( const T & value ) const{
+		for(index_type i = first(); i != 0; i = m_slots[i].next){
+			if(*slot(i) == value) return const_iterator(this, i);
+		}
+		return cend();
+	}
+
+	//=======================================================================================
+
+	//OPERATIONS
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::splice( const_iterator pos, const_iterator it ){
+		if(pos.index == it.index || pos.index == m_slots[it.index].next) return;
+
+		splice(pos, it, const_iterator(this, m_slots[it.index].next));
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::splice( const_iterator pos, const_iterator first, const_iterator last ){
+		if(first == last || pos == last) return;
+
+		index_type f = first.index;
+		index_type l = m_slots[last.index].prev;
+
+		// Unlinks [f; l] and links it back before pos.
+		m_slots[m_slots[f].prev].next = last.index;
+		m_slots[last.index].prev = m_slots[f].prev;
+
+		index_type before = m_slots[pos.index].prev;
+		m_slots[before].next = f;
+		m_slots[f].prev = before;
+		m_slots[l].next = pos.index;
+		m_slots[pos.index].prev = l;
+	}
+
+	template<typename T, typename Allocator>
+	void compact_list<T,Allocator>::reverse(){
+		if(m_size < 2) return;
+
+		index_type i = 0;
+		do{
+			std::swap(m_slots[i].prev, m_slots[i].next);
+			i = m_slots[i].prev;
+		}while(i != 0);
+	}
+
+	template<typename T, typename Allocator>
+	bool compact_list<T,Allocator>::operator==( const compact_list & rhs ) const{
+		if(m_size != rhs.m_size) return false;
+
+		for(index_type i = first(), j = rhs.first(); i != 0; i = m_slots[i].next, j = rhs.m_slots[j].next){
+			if(!( *slot(i) == *rhs.slot(j) )) return false;
+		}
+		return true;
+	}
+}
+
+#endif
@@ -0,0 +1,503 @@
+#ifndef CONCURRENT_LIST_H
+#define CONCURRENT_LIST_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "node_pool.h"
+
+namespace ls{
+template<typename T, typename Allocator = pool_allocator<T> >
+
+	/* <! A double linked list that many threads may change at once. Every node has its own lock:
+		an insertion locks the two nodes around the gap and an erasure the node and its two
+		neighbours, so threads working on different parts of the list never wait for each other.
+		Locks are always taken left to right; a lock to the left of one already held is only tried,
+		and on failure everything is released and the operation starts over, so there is no deadlock.
+
+		Erased nodes are reclaimed by reference counting: the list holds one reference to each
+		linked node and every iterator one more. An erased node keeps a reference to the node that
+		followed it, so an iterator parked on it can still step forward. The last reference frees it.
+
+		Elements are read-only once inserted. Iterators must not outlive the list, and the list must
+		not be destroyed while other threads still use it. The allocator is used from every thread.
+	*/
+	class concurrent_list
+	{
+		private:
+			/* <! Test and test-and-set lock, small enough for one per node. */
+			class spin_lock{
+				public:
+					void lock() noexcept;
+					bool try_lock() noexcept { return !m_flag.load(std::memory_order_relaxed) && !m_flag.exchange(true, std::memory_order_acquire); }
+					void unlock() noexcept { m_flag.store(false, std::memory_order_release); }
+
+				private:
+					std::atomic<bool> m_flag{ false };
+			};
+
+			/* <! Links, lock and reference count. The two sentinels are bare NodeBases. */
+			struct NodeBase{
+				NodeBase *prev = nullptr;          //<! Pointer to the previous node; guarded by lock.
+				NodeBase *next = nullptr;          //<! Pointer to the next node; guarded by lock.
+				spin_lock lock;                    //<! Guards the links of this node.
+				std::atomic<int> refs{ 0 };        //<! The list's reference while linked, plus one per iterator.
+				std::atomic<bool> linked{ true };  //<! False once erased; only written under lock.
+			};
+
+			/* <! A node that carries data. The data is built in place by the allocator. */
+			struct Node : NodeBase{
+				T data;     //<! Data field
+			};
+
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_allocator_type;
+			typedef std::allocator_traits<node_allocator_type> node_traits;
+
+		public:
+			typedef Allocator allocator_type;
+
+			/* <! Forward iterator that keeps its node alive. Skips the nodes erased under it. */
+			class iterator{
+				public:
+					typedef const T& const_reference;
+					typedef const T* const_pointer;
+
+					iterator() = default;
+					iterator( const iterator & other ) : m_owner(other.m_owner), m_current(other.m_current){ if(m_current) m_owner->acquire(m_current); }
+					iterator( iterator && other ) noexcept : m_owner(other.m_owner), m_current(other.m_current){ other.m_current = nullptr; }
+					iterator & operator=( iterator other ) noexcept { std::swap(m_owner, other.m_owner); std::swap(m_current, other.m_current); return *this; }
+					~iterator(){ if(m_current) m_owner->release(m_current); }
+
+					const_reference operator*() const { return static_cast<Node*>(m_current)->data; }
+					const_pointer operator->() const { return std::addressof( static_cast<Node*>(m_current)->data ); }
+
+					/* <! Moves to the next element still in the list, or to end(). */
+					iterator & operator++();
+
+					bool operator==( const iterator & rhs ) const { return m_current == rhs.m_current; }
+					bool operator!=( const iterator & rhs ) const { return m_current != rhs.m_current; }
+
+				private:
+					/* <! Takes over a reference already counted for current. */
+					iterator( const concurrent_list * owner, NodeBase * current ) : m_owner(owner), m_current(current){ /*empty*/ }
+
+					const concurrent_list *m_owner = nullptr;
+					NodeBase *m_current = nullptr;
+
+					friend class concurrent_list;
+			};
+
+			// [I] SPECIAL MEMBERS
+			concurrent_list() : concurrent_list( Allocator() ){ /*empty*/ }
+			explicit concurrent_list( const Allocator & alloc );
+			concurrent_list( const concurrent_list & ) = delete;
+			concurrent_list & operator= ( const concurrent_list & ) = delete;
+
+			/* <! Destroys the list. No other thread may be using it. */
+			~concurrent_list();
+
+			//[II] ITERATORS
+			iterator begin() const;
+			iterator end() const { return iterator(this, tail()); }
+
+			//[III] CAPACITY
+			/* <! Number of elements; only a snapshot while other threads are changing the list. */
+			int size() const { return m_size.load(std::memory_order_relaxed); }
+			bool empty() const { return size() == 0; }
+
+			//[IV] MODIFIERS
+			void push_front( const T & value ){ emplace_front(value); }
+			void push_front( T && value ){ emplace_front(std::move(value)); }
+			void push_back( const T & value ){ emplace_back(value); }
+			void push_back( T && value ){ emplace_back(std::move(value)); }
+
+			template<typename... Args>
+			void emplace_front( Args &&... args );
+
+			template<typename... Args>
+			void emplace_back( Args &&... args );
+
+			/* <! Removes the first element.
+				@return The element, or nothing if the list was empty.
+			*/
+			std::optional<T> pop_front();
+
+			/* <! Removes the last element.
+				@return The element, or nothing if the list was empty.
+			*/
+			std::optional<T> pop_back();
+
+			/* <! Removes every element. Elements inserted meanwhile by other threads may stay. */
+			void clear();
+
+			//[IV-a] MODIFIERS WITH ITERATORS
+
+			/* <! Builds a value in place right after pos.
+				@return The iterator to the new value, or end() if pos is end() or was erased in the meantime.
+			*/
+			template<typename... Args>
+			iterator emplace_after( const iterator & pos, Args &&... args );
+
+			iterator insert_after( const iterator & pos, const T & value ){ return emplace_after(pos, value); }
+			iterator insert_after( const iterator & pos, T && value ){ return emplace_after(pos, std::move(value)); }
+
+			/* <! Removes the element at pos.
+				@return True if this call removed it; false if it was already gone.
+			*/
+			bool erase( const iterator & pos );
+
+			/* <! Search for a value, locking two nodes at a time.
+				@return The iterator to the first element equal to value, or end().
+			*/
+			iterator find( const T & value ) const;
+
+			/* <! Calls f on every element, in order, while the element is locked. f must not use the list. */
+			template<typename F>
+			void for_each( F f ) const;
+
+		private:
+			NodeBase * head() const { return const_cast<NodeBase*>(&m_head); }
+			NodeBase * tail() const { return const_cast<NodeBase*>(&m_tail); }
+			bool is_sentinel( const NodeBase * n ) const { return n == &m_head || n == &m_tail; }
+
+			/* <! Adds a reference to n. */
+			void acquire( NodeBase * n ) const;
+
+			/* <! Drops a reference to n, freeing it and the chain of erased nodes it kept alive. */
+			void release( NodeBase * n ) const;
+
+			/* <! Allocates a node, with one reference for the list, and builds its data. */
+			template<typename... Args>
+			Node * create_node( Args &&... args );
+
+			/* <! Links x between p and n; both are locked and adjacent. */
+			void link( NodeBase * p, Node * x, NodeBase * n );
+
+			/* <! Unlinks x from between p and n; all three are locked. The list's reference is left to the caller. */
+			void unlink( NodeBase * p, NodeBase * x, NodeBase * n );
+
+			/* <! Takes the element out of a node just unlinked, moving it if nobody else can see it. */
+			static std::optional<T> take( NodeBase * x );
+
+			mutable node_allocator_type m_alloc;
+			NodeBase m_head; //<! Left sentinel: m_head.next is the first node.
+			NodeBase m_tail; //<! Right sentinel: m_tail.prev is the last node.
+			std::atomic<int> m_size{ 0 };
+	};
+
+	//=======================================================================================
+
+	//LOCKS AND REFERENCES
+	template<typename T, typename Allocator>
+	void concurrent_list<T,Allocator>::spin_lock::lock() noexcept{
+		while( m_flag.exchange(true, std::memory_order_acquire) ){
+			while( m_flag.load(std::memory_order_relaxed) ){
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	template<typename T, typename Allocator>
+	void concurrent_list<T,Allocator>::acquire( NodeBase * n ) const{
+		if( !is_sentinel(n) ) n->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	template<typename T, typename Allocator>
+	void concurrent_list<T,Allocator>::release( NodeBase * n ) const{
+		// Iterative, so a long chain of erased nodes does not recurse.
+		while( n != nullptr && !is_sentinel(n) && n->refs.fetch_sub(1, std::memory_order_acq_rel) == 1 ){
+			Node *temp = static_cast<Node*>(n);
+			n = n->next;
+			node_traits::destroy(m_alloc, std::addressof(temp->data));
+			temp->NodeBase::~NodeBase();
+			node_traits::deallocate(m_alloc, temp, 1);
+		}
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	typename concurrent_list<T,Allocator>::Node * concurrent_list<T,Allocator>::create_node( Args &&... args ){
+		Node *temp = node_traits::allocate(m_alloc, 1);
+
+		try{
+			node_traits::construct(m_alloc, std::addressof(temp->data), std::forward<Args>(args)...);
+		}catch(...){
+			node_traits::deallocate(m_alloc, temp, 1);
+			throw;
+		}
+		::new( static_cast<void*>( static_cast<NodeBase*>(temp) ) ) NodeBase();
+
+		temp->refs.store(1, std::memory_order_relaxed);
+		return temp;
+	}
+
+	template<typename T, typename Allocator>
+	void concurrent_list<T,Allocator>::link( NodeBase * p, Node * x, NodeBase * n ){
+		x->prev = p;
+		x->next = n;
+		p->next = x;
+		n->prev = x;
+		m_size.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	template<typename T, typename Allocator>
+	void concurrent_list<T,Allocator>::unlink( NodeBase * p, NodeBase * x, NodeBase * n ){
+		p->next = n;
+		n->prev = p;
+		x->linked.store(false, std::memory_order_release);
+		// x->next stays valid for the iterators parked on x.
+		acquire(n);
+		m_size.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	template<typename T, typename Allocator>
+	std::optional<T> concurrent_list<T,Allocator>::take( NodeBase * x ){
+		// With x and its old neighbours locked, no new reference to x can appear.
+		if( x->refs.load(std::memory_order_acquire) == 1 ){
+			return std::optional<T>( std::move( static_cast<Node*>(x)->data ) );
+		}
+		return std::optional<T>( static_cast<Node*>(x)->data );
+	}
+
+	//=======================================================================================
+
+	//ITERATOR
+	template<typename T, typename Allocator>
+	typename concurrent_list<T,Allocator>::iterator & concurrent_list<T,Allocator>::iterator::operator++(){
+		do{
+			NodeBase *x = m_current;
+			x->lock.lock();
+			NodeBase *n = x->next;
+			m_owner->acquire(n);
+			x->lock.unlock();
+			m_owner->release(x);
+			m_current = n;
+		}while( m_current != m_owner->tail() && !m_current->linked.load(std::memory_order_acquire) );
+
+		return *this;
+	}
+
+	//=======================================================================================
+
+	//SPECIAL MEMBERS
+	template<typename T, typename Allocator>
+	concurrent_list<T,Allocator>::concurrent_list( const Allocator & alloc ) : m_alloc(alloc){
+		m_head.next = &m_tail;
+		m_tail.prev = &m_head;
+	}
+
+	template<typename T, typename Allocator>
+	concurrent_list<T,Allocator>::~concurrent_list(){
+		NodeBase *n = m_head.next;
+
+		while( n != &m_tail ){
+			// A linked node holds no reference to the next one.
+			NodeBase *next = n->next;
+			n->next = nullptr;
+			release(n);
+			n = next;
+		}
+	}
+
+	template<typename T, typename Allocator>
+	typename concurrent_list<T,Allocator>::iterator concurrent_list<T,Allocator>::begin() const{
+		NodeBase *h = head();
+		h->lock.lock();
+		NodeBase *n = h->next;
+		acquire(n);
+		h->lock.unlock();
+
+		return iterator(this, n);
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	void concurrent_list<T,Allocator>::emplace_front( Args &&... args ){
+		Node *temp = create_node(std::forward<Args>(args)...);
+
+		m_head.lock.lock();
+		NodeBase *n = m_head.next;
+		n->lock.lock();
+		link(&m_head, temp, n);
+		n->lock.unlock();
+		m_head.lock.unlock();
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	void concurrent_list<T,Allocator>::emplace_back( Args &&... args ){
+		Node *temp = create_node(std::forward<Args>(args)...);
+
+		for(;;){
+			m_tail.lock.lock();
+			// The last node cannot be erased while the tail is held, but it is to the left: only try it.
+			NodeBase *p = m_tail.prev;
+			if( p->lock.try_lock() ){
+				link(p, temp, &m_tail);
+				p->lock.unlock();
+				m_tail.lock.unlock();
+				return;
+			}
+			m_tail.lock.unlock();
+			std::this_thread::yield();
+		}
+	}
+
+	template<typename T, typename Allocator>
+	std::optional<T> concurrent_list<T,Allocator>::pop_front(){
+		m_head.lock.lock();
+		NodeBase *x = m_head.next;
+		if( x == &m_tail ){
+			m_head.lock.unlock();
+			return std::nullopt;
+		}
+
+		x->lock.lock();
+		NodeBase *n = x->next;
+		n->lock.lock();
+		unlink(&m_head, x, n);
+		std::optional<T> value = take(x);
+		n->lock.unlock();
+		x->lock.unlock();
+		m_head.lock.unlock();
+
+		release(x);
+		return value;
+	}
+
+	template<typename T, typename Allocator>
+	std::optional<T> concurrent_list<T,Allocator>::pop_back(){
+		for(;;){
+			m_tail.lock.lock();
+			NodeBase *x = m_tail.prev;
+			if( x == &m_head ){
+				m_tail.lock.unlock();
+				return std::nullopt;
+			}
+
+			if( x->lock.try_lock() ){
+				NodeBase *p = x->prev;
+				if( p->lock.try_lock() ){
+					unlink(p, x, &m_tail);
+					std::optional<T> value = take(x);
+					p->lock.unlock();
+					x->lock.unlock();
+					m_tail.lock.unlock();
+
+					release(x);
+					return value;
+				}
+				x->lock.unlock();
+			}
+			m_tail.lock.unlock();
+			std::this_thread::yield();
+		}
+	}
+
+	template<typename T, typename Allocator>
+	void concurrent_list<T,Allocator>::clear(){
+		while( pop_front() ){ /*empty*/ }
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS WITH ITERATORS
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	typename concurrent_list<T,Allocator>::iterator concurrent_list<T,Allocator>::emplace_after( const iterator & pos, Args &&... args ){
+		NodeBase *x = pos.m_current;
+		if( x == &m_tail ) return end();
+
+		Node *temp = create_node(std::forward<Args>(args)...);
+		x->lock.lock();
+		if( !x->linked.load(std::memory_order_relaxed) ){
+			x->lock.unlock();
+			release(temp);
+			return end();
+		}
+
+		NodeBase *n = x->next;
+		n->lock.lock();
+		link(x, temp, n);
+		acquire(temp);
+		n->lock.unlock();
+		x->lock.unlock();
+
+		return iterator(this, temp);
+	}
+
+	template<typename T, typename Allocator>
+	bool concurrent_list<T,Allocator>::erase( const iterator & pos ){
+		NodeBase *x = pos.m_current;
+		if( is_sentinel(x) ) return false;
+
+		for(;;){
+			x->lock.lock();
+			if( !x->linked.load(std::memory_order_relaxed) ){
+				x->lock.unlock();
+				return false;
+			}
+
+			// The previous node cannot go away while x is held, but it is to the left: only try it.
+			NodeBase *p = x->prev;
+			if( p->lock.try_lock() ){
+				NodeBase *n = x->next;
+				n->lock.lock();
+				unlink(p, x, n);
+				n->lock.unlock();
+				x->lock.unlock();
+				p->lock.unlock();
+
+				release(x);
+				return true;
+			}
+			x->lock.unlock();
+			std::this_thread::yield();
+		}
+	}
+
+	template<typename T, typename Allocator>
+	typename concurrent_list<T,Allocator>::iterator concurrent_list<T,Allocator>::find( const T & value ) const{
+		NodeBase *p = head();
+		p->lock.lock();
+
+		// Hand over hand: the next node is locked before the current one is let go.
+		for( NodeBase *x = p->next; x != &m_tail; x = x->next ){
+			x->lock.lock();
+			p->lock.unlock();
+			if( static_cast<Node*>(x)->data == value ){
+				acquire(x);
+				x->lock.unlock();
+				return iterator(this, x);
+			}
+			p = x;
+		}
+
+		p->lock.unlock();
+		return end();
+	}
+
+	template<typename T, typename Allocator>
+	template<typename F>
+	void concurrent_list<T,Allocator>::for_each( F f ) const{
+		NodeBase *p = head();
+		p->lock.lock();
+
+		for( NodeBase *x = p->next; x != &m_tail; x = x->next ){
+			x->lock.lock();
+			p->lock.unlock();
+			f( static_cast<const Node*>(x)->data );
+			p = x;
+		}
+
+		p->lock.unlock();
+	}
+}
+
+#endif
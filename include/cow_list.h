@@ -0,0 +1,238 @@
+#ifndef COW_LIST_H
+#define COW_LIST_H
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "list.h"
+
+namespace ls{
+template<typename T, typename Allocator = pool_allocator<T> >
+
+	/* <! Copy-on-write handle to an ls::list. Copies share one reference-counted chain, so copying,
+		or handing the list to a reader on another thread, costs O(1) whatever the size. The first
+		edit through a handle whose chain is shared clones the chain for that handle alone.
+		Handles sharing a chain may be used from different threads, as long as each handle is used
+		by one thread at a time. References and iterators taken from a handle are invalidated by
+		its next edit, which may move it to a fresh chain.
+	*/
+	class cow_list
+	{
+		public:
+			typedef list<T, Allocator> list_type;
+			typedef typename list_type::const_iterator const_iterator;
+			typedef Allocator allocator_type;
+
+			/* <! Empty list. Nothing is allocated until the first edit. */
+			explicit cow_list( const Allocator & alloc = Allocator() ) : m_alloc(alloc) { /*empty*/ }
+
+			/* <! Takes the nodes of seq, without copying them. */
+			explicit cow_list( list_type && seq );
+
+			/* <! Copies seq once; later copies of this handle share that copy. */
+			explicit cow_list( const list_type & seq ) : cow_list( list_type(seq) ) { /*empty*/ }
+
+			cow_list( std::initializer_list<T> ilist, const Allocator & alloc = Allocator() ) : cow_list( list_type(ilist, alloc) ) { /*empty*/ }
+
+			/* <! Shares the chain of other: O(1). If other has lent its list through edit(), the list is
+				copied instead, so edits through that reference stay out of this handle.
+			*/
+			cow_list( const cow_list & other );
+			cow_list( cow_list && other ) noexcept;
+			~cow_list(){ release(); }
+
+			cow_list & operator= ( const cow_list & other );
+			cow_list & operator= ( cow_list && other ) noexcept;
+
+			//[I] READING
+			/* <! The list itself, shared with the other handles of its chain. */
+			const list_type & view() const noexcept;
+
+			const_iterator begin() const { return view().cbegin(); }
+			const_iterator end() const { return view().cend(); }
+			const_iterator cbegin() const { return view().cbegin(); }
+			const_iterator cend() const { return view().cend(); }
+
+			int size() const { return view().size(); }
+			bool empty() const { return view().empty(); }
+			const T & front() const { return view().front(); }
+			const T & back() const { return view().back(); }
+			const_iterator find( const T & value ) const { return view().find(value); }
+
+			/* <! True if no other handle shares the chain, so an edit will not clone it. */
+			bool unique() const noexcept;
+
+			/* <! True if both handles share one chain, in which case they are equal without a comparison. */
+			bool shares( const cow_list & other ) const noexcept { return m_shared != nullptr && m_shared == other.m_shared; }
+
+			bool operator== ( const cow_list & rhs ) const { return shares(rhs) || view() == rhs.view(); }
+			bool operator!= ( const cow_list & rhs ) const { return !(*this == rhs); }
+
+			//[II] EDITING
+			/* <! The list, for any edit: clones the chain first if it is shared. The list is then lent
+				out: until the next edit through another member of this handle, copies of the handle
+				get their own copy of the list instead of sharing it, so the reference never reaches them.
+				@return The list, owned by this handle alone.
+			*/
+			list_type & edit();
+
+			void push_back( const T & value ){ mutate().push_back(value); }
+			void push_back( T && value ){ mutate().push_back(std::move(value)); }
+			void push_front( const T & value ){ mutate().push_front(value); }
+			void push_front( T && value ){ mutate().push_front(std::move(value)); }
+			void pop_back(){ mutate().pop_back(); }
+			void pop_front(){ mutate().pop_front(); }
+
+			/* <! Lets go of the chain, without cloning it when it is shared. */
+			void clear() noexcept { release(); }
+
+		private:
+			/* <! The chain and the number of handles on it. */
+			struct shared{
+				std::atomic<long> refs{ 1 };
+				list_type seq;
+
+				explicit shared( list_type && s ) : seq( std::move(s) ) { /*empty*/ }
+			};
+
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<shared> shared_allocator_type;
+			typedef std::allocator_traits<shared_allocator_type> shared_traits;
+
+			/* <! A new chain holding seq, with a count of one. */
+			shared * create( list_type && seq );
+
+			/* <! The list, cloned first if the chain is shared, and no longer lent out. */
+			list_type & mutate();
+
+			/* <! The chain for a new handle on the list of other: other's own, or a copy if it is lent out. */
+			static shared * share( const cow_list & other );
+
+			/* <! Drops this handle's count, freeing the chain with the last one, and leaves the handle empty. */
+			void release() noexcept;
+
+			/* <! The list of handles that have no chain. */
+			static const list_type & empty_list();
+
+			shared_allocator_type m_alloc;
+			shared *m_shared = nullptr;
+			bool m_lent = false; //<! Set by edit(): a reference to the list may be held outside.
+	};
+
+	//=======================================================================================
+
+	template<typename T, typename Allocator>
+	cow_list<T,Allocator>::cow_list( list_type && seq ) : m_alloc(seq.get_allocator()){
+		m_shared = create( std::move(seq) );
+	}
+
+	template<typename T, typename Allocator>
+	cow_list<T,Allocator>::cow_list( const cow_list & other ) : m_alloc(other.m_alloc), m_shared(share(other)){
+		/*empty*/
+	}
+
+	template<typename T, typename Allocator>
+	cow_list<T,Allocator>::cow_list( cow_list && other ) noexcept : m_alloc(other.m_alloc), m_shared(other.m_shared), m_lent(other.m_lent){
+		other.m_shared = nullptr;
+		other.m_lent = false;
+	}
+
+	template<typename T, typename Allocator>
+	cow_list<T,Allocator> & cow_list<T,Allocator>::operator= ( const cow_list & other ){
+		if(m_shared != other.m_shared){
+			// Taken before letting go, so a throw while copying a lent list leaves this handle as it was.
+			shared *chain = share(other);
+			release();
+			m_alloc = other.m_alloc;
+			m_shared = chain;
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	cow_list<T,Allocator> & cow_list<T,Allocator>::operator= ( cow_list && other ) noexcept{
+		if(this != &other){
+			release();
+			m_alloc = other.m_alloc;
+			m_shared = other.m_shared;
+			m_lent = other.m_lent;
+			other.m_shared = nullptr;
+			other.m_lent = false;
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	const typename cow_list<T,Allocator>::list_type & cow_list<T,Allocator>::view() const noexcept{
+		return m_shared ? m_shared->seq : empty_list();
+	}
+
+	template<typename T, typename Allocator>
+	bool cow_list<T,Allocator>::unique() const noexcept{
+		// Acquire pairs with the release of the other handles, so their reads are over before an edit.
+		return m_shared == nullptr || m_shared->refs.load(std::memory_order_acquire) == 1;
+	}
+
+	template<typename T, typename Allocator>
+	typename cow_list<T,Allocator>::list_type & cow_list<T,Allocator>::edit(){
+		list_type &seq = mutate();
+		m_lent = true;
+		return seq;
+	}
+
+	template<typename T, typename Allocator>
+	typename cow_list<T,Allocator>::list_type & cow_list<T,Allocator>::mutate(){
+		if(m_shared == nullptr){
+			m_shared = create( list_type(Allocator(m_alloc)) );
+		}else if(!unique()){
+			// The clone stays on this handle's allocator, whatever a container copy would select.
+			shared *clone = create( list_type(m_shared->seq, Allocator(m_alloc)) );
+			release();
+			m_shared = clone;
+		}
+		m_lent = false;
+		return m_shared->seq;
+	}
+
+	template<typename T, typename Allocator>
+	typename cow_list<T,Allocator>::shared * cow_list<T,Allocator>::share( const cow_list & other ){
+		if(other.m_lent){
+			cow_list clone( list_type(other.m_shared->seq, Allocator(other.m_alloc)) );
+			return std::exchange(clone.m_shared, nullptr);
+		}
+		// A new count needs no ordering: other's own count keeps the chain alive meanwhile.
+		if(other.m_shared) other.m_shared->refs.fetch_add(1, std::memory_order_relaxed);
+		return other.m_shared;
+	}
+
+	template<typename T, typename Allocator>
+	typename cow_list<T,Allocator>::shared * cow_list<T,Allocator>::create( list_type && seq ){
+		shared *block = shared_traits::allocate(m_alloc, 1);
+		try{
+			shared_traits::construct(m_alloc, block, std::move(seq));
+		}catch(...){
+			shared_traits::deallocate(m_alloc, block, 1);
+			throw;
+		}
+		return block;
+	}
+
+	template<typename T, typename Allocator>
+	void cow_list<T,Allocator>::release() noexcept{
+		if(m_shared && m_shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1){
+			shared_traits::destroy(m_alloc, m_shared);
+			shared_traits::deallocate(m_alloc, m_shared, 1);
+		}
+		m_shared = nullptr;
+		m_lent = false;
+	}
+
+	template<typename T, typename Allocator>
+	const typename cow_list<T,Allocator>::list_type & cow_list<T,Allocator>::empty_list(){
+		static const list_type seq;
+		return seq;
+	}
+}
+
+#endif
@@ -0,0 +1,286 @@
+#ifndef FINGERPRINTED_LIST_H
+#define FINGERPRINTED_LIST_H
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "list.h"
+
+namespace ls{
+template<typename T, typename Hash = std::hash<T>, typename Allocator = pool_allocator<T> >
+
+	/* <! A list that keeps a fingerprint of its contents up to date on every insertion and removal,
+		so two lists with different contents are told apart in O(1), before any traversal.
+		The fingerprint is a sum of mixed element hashes: it only depends on which elements the list
+		holds, which is what makes the O(1) update possible anywhere in the list. Lists that differ
+		only in the order of their elements fall back to the element by element comparison.
+		Elements are read-only in place; replace them through erase and insert.
+	*/
+	class fingerprinted_list
+	{
+		public:
+			typedef list<T,Allocator> list_type;
+			typedef typename list_type::const_iterator const_iterator;
+
+			// [I] SPECIAL MEMBERS
+			fingerprinted_list() = default;
+
+			/* <! Constructs the list with the contents of the initializer list ilist. */
+			fingerprinted_list( std::initializer_list<T> ilist );
+
+			/* <! Constructs the list with the contents of the range [first,last). */
+			template<typename InputIt>
+			fingerprinted_list( InputIt first, InputIt last );
+
+			/* <! Takes the nodes of a plain list and hashes them once. */
+			explicit fingerprinted_list( list_type && items );
+
+			fingerprinted_list( const fingerprinted_list & ) = default;
+			fingerprinted_list( fingerprinted_list && other ) noexcept;
+			fingerprinted_list & operator= ( const fingerprinted_list & ) = default;
+			fingerprinted_list & operator= ( fingerprinted_list && other ) noexcept;
+
+			//[II] ITERATORS
+			const_iterator begin() const { return m_list.cbegin(); }
+			const_iterator end() const { return m_list.cend(); }
+			const_iterator cbegin() const { return m_list.cbegin(); }
+			const_iterator cend() const { return m_list.cend(); }
+
+			//[III] CAPACITY
+			int size() const { return m_list.size(); }
+			bool empty() const { return m_list.empty(); }
+
+			//[IV] MODIFIERS
+			const T & front() const { return m_list.front(); }
+			const T & back() const { return m_list.back(); }
+
+			void push_front( const T & value );
+			void push_front( T && value );
+			void push_back( const T & value );
+			void push_back( T && value );
+
+			template<typename... Args>
+			const T & emplace_front( Args &&... args );
+
+			template<typename... Args>
+			const T & emplace_back( Args &&... args );
+
+			void pop_front();
+			void pop_back();
+			void clear();
+
+			/* <! Builds a value in place before pos.
+				@return The iterator to the new value.
+			*/
+			template<typename... Args>
+			const_iterator emplace( const_iterator pos, Args &&... args );
+
+			const_iterator insert( const_iterator pos, const T & value );
+			const_iterator insert( const_iterator pos, T && value );
+
+			/* <! Removes the object at pos.
+				@return Iterator to the element after pos.
+			*/
+			const_iterator erase( const_iterator pos );
+
+			/* <! Removes the objects on the range [first; last).
+				@return Iterator to last.
+			*/
+			const_iterator erase( const_iterator first, const_iterator last );
+
+			/* <! Moves every element of other before pos in O(1); the fingerprints move along. */
+			void splice( const_iterator pos, fingerprinted_list & other );
+
+			const_iterator find( const T & value ) const { return m_list.find(value); }
+
+			/* <! Returns the fingerprint of the contents. Equal lists have equal fingerprints. */
+			std::size_t fingerprint() const { return m_fingerprint; }
+
+			/* <! Read-only access to the underlying list. */
+			const list_type & items() const { return m_list; }
+
+			//[V] COMPARISONS
+			// == and != reject on size or fingerprint before walking the lists.
+			bool operator==( const fingerprinted_list & rhs ) const;
+			bool operator!=( const fingerprinted_list & rhs ) const { return !(*this == rhs); }
+			bool operator<( const fingerprinted_list & rhs ) const { return m_list < rhs.m_list; }
+			bool operator>( const fingerprinted_list & rhs ) const { return m_list > rhs.m_list; }
+			bool operator<=( const fingerprinted_list & rhs ) const { return m_list <= rhs.m_list; }
+			bool operator>=( const fingerprinted_list & rhs ) const { return m_list >= rhs.m_list; }
+
+		private:
+			/* <! Spreads the bits of a hash, so that summing them does not cancel out patterns. */
+			static std::size_t mix( std::size_t h );
+
+			std::size_t hash_of( const T & value ) const { return mix( m_hash(value) ); }
+
+			list_type m_list;
+			Hash m_hash;
+			std::size_t m_fingerprint = 0; //<! Sum, modulo 2^64, of the mixed hash of every element.
+	};
+
+	//=======================================================================================
+
+	//SPECIAL MEMBERS
+	template<typename T, typename Hash, typename Allocator>
+	fingerprinted_list<T,Hash,Allocator>::fingerprinted_list( std::initializer_list<T> ilist ){
+		for(auto &i : ilist){
+			push_back(i);
+		}
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	template<typename InputIt>
+	fingerprinted_list<T,Hash,Allocator>::fingerprinted_list( InputIt first, InputIt last ){
+		for(auto i(first); i != last; ++i){
+			push_back(*i);
+		}
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	fingerprinted_list<T,Hash,Allocator>::fingerprinted_list( list_type && items ) : m_list(std::move(items)){
+		for(auto i(m_list.cbegin()); i != m_list.cend(); ++i){
+			m_fingerprint += hash_of(*i);
+		}
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	fingerprinted_list<T,Hash,Allocator>::fingerprinted_list( fingerprinted_list && other ) noexcept :
+		m_list(std::move(other.m_list)), m_hash(other.m_hash), m_fingerprint(other.m_fingerprint){
+		other.m_fingerprint = 0;
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	fingerprinted_list<T,Hash,Allocator> & fingerprinted_list<T,Hash,Allocator>::operator= ( fingerprinted_list && other ) noexcept{
+		if(this == &other) return *this;
+
+		m_list = std::move(other.m_list);
+		m_hash = other.m_hash;
+		m_fingerprint = other.m_fingerprint;
+		other.m_fingerprint = 0;
+
+		return *this;
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::push_front( const T & value ){
+		emplace_front(value);
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::push_front( T && value ){
+		emplace_front(std::move(value));
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::push_back( const T & value ){
+		emplace_back(value);
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::push_back( T && value ){
+		emplace_back(std::move(value));
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	template<typename... Args>
+	const T & fingerprinted_list<T,Hash,Allocator>::emplace_front( Args &&... args ){
+		const T &value = m_list.emplace_front(std::forward<Args>(args)...);
+		m_fingerprint += hash_of(value);
+		return value;
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	template<typename... Args>
+	const T & fingerprinted_list<T,Hash,Allocator>::emplace_back( Args &&... args ){
+		const T &value = m_list.emplace_back(std::forward<Args>(args)...);
+		m_fingerprint += hash_of(value);
+		return value;
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::pop_front(){
+		m_fingerprint -= hash_of(m_list.front());
+		m_list.pop_front();
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::pop_back(){
+		m_fingerprint -= hash_of(m_list.back());
+		m_list.pop_back();
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::clear(){
+		m_list.clear();
+		m_fingerprint = 0;
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	template<typename... Args>
+	typename fingerprinted_list<T,Hash,Allocator>::const_iterator fingerprinted_list<T,Hash,Allocator>::emplace( const_iterator pos, Args &&... args ){
+		const_iterator temp = m_list.emplace(pos, std::forward<Args>(args)...);
+		m_fingerprint += hash_of(*temp);
+		return temp;
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	typename fingerprinted_list<T,Hash,Allocator>::const_iterator fingerprinted_list<T,Hash,Allocator>::insert( const_iterator pos, const T & value ){
+		return emplace(pos, value);
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	typename fingerprinted_list<T,Hash,Allocator>::const_iterator fingerprinted_list<T,Hash,Allocator>::insert( const_iterator pos, T && value ){
+		return emplace(pos, std::move(value));
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	typename fingerprinted_list<T,Hash,Allocator>::const_iterator fingerprinted_list<T,Hash,Allocator>::erase( const_iterator pos ){
+		if(pos == m_list.cend()) return pos;
+
+		m_fingerprint -= hash_of(*pos);
+		return m_list.erase(pos);
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	typename fingerprinted_list<T,Hash,Allocator>::const_iterator fingerprinted_list<T,Hash,Allocator>::erase( const_iterator first, const_iterator last ){
+		while(first != last){
+			first = erase(first);
+		}
+		return first;
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	void fingerprinted_list<T,Hash,Allocator>::splice( const_iterator pos, fingerprinted_list & other ){
+		if(this == &other) return;
+
+		m_list.splice(pos, other.m_list);
+		m_fingerprint += other.m_fingerprint;
+		other.m_fingerprint = 0;
+	}
+
+	//=======================================================================================
+
+	//COMPARISONS
+	template<typename T, typename Hash, typename Allocator>
+	bool fingerprinted_list<T,Hash,Allocator>::operator==( const fingerprinted_list & rhs ) const{
+		if(m_fingerprint != rhs.m_fingerprint || size() != rhs.size()) return false;
+		return m_list == rhs.m_list;
+	}
+
+	template<typename T, typename Hash, typename Allocator>
+	std::size_t fingerprinted_list<T,Hash,Allocator>::mix( std::size_t h ){
+		// Finalizer of splitmix64.
+		std::uint64_t z = static_cast<std::uint64_t>(h) + 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return static_cast<std::size_t>(z ^ (z >> 31));
+	}
+}
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef INDEXED_FIND_LIST_H
+#define INDEXED_FIND_LIST_H
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "list.h"
+
+namespace ls{
+	/* <! Key extractor that uses the whole element as its key. */
+	struct identity{
+		template<typename T>
+		const T & operator()( const T & value ) const noexcept { return value; }
+	};
+
+template<typename T, typename KeyOf = identity, typename Hash = std::hash< std::decay_t< std::invoke_result_t<KeyOf, const T&> > >,
+	typename KeyEqual = std::equal_to< std::decay_t< std::invoke_result_t<KeyOf, const T&> > >, typename Allocator = pool_allocator<T> >
+
+	/* <! A list with a hash index from the key of every element to its node, kept up to date on
+		every insertion and removal. find, contains, count and erase by key cost O(1) on average
+		instead of a scan. Iterators stay valid exactly as in ls::list.
+		Elements are read-only in place, since changing one could change its key; replace them
+		through erase and insert.
+	*/
+	class indexed_find_list
+	{
+		public:
+			typedef list<T,Allocator> list_type;
+			typedef typename list_type::const_iterator const_iterator;
+			typedef std::decay_t< std::invoke_result_t<KeyOf, const T&> > key_type;
+
+			// [I] SPECIAL MEMBERS
+			indexed_find_list() = default;
+
+			/* <! Constructs the list with the contents of the initializer list ilist. */
+			indexed_find_list( std::initializer_list<T> ilist );
+
+			/* <! Constructs the list with the contents of the range [first,last). */
+			template<typename InputIt>
+			indexed_find_list( InputIt first, InputIt last );
+
+			/* <! Takes the nodes of a plain list and indexes them once. */
+			explicit indexed_find_list( list_type && items );
+
+			/* <! Copies the elements; the copy gets an index of its own nodes. */
+			indexed_find_list( const indexed_find_list & other );
+
+			/* <! Copy assigns. The elements are copied and indexed apart first, so if that throws
+				this list is left as it was.
+			*/
+			indexed_find_list & operator= ( const indexed_find_list & other );
+
+			// A moved-constructed list keeps other's nodes, so the index moves along.
+			indexed_find_list( indexed_find_list && ) = default;
+
+			/* <! Move assigns. When the list takes other's nodes, the index moves along in O(1); when the
+				allocators differ and do not propagate, the nodes are rebuilt one by one and so is the index.
+			*/
+			indexed_find_list & operator= ( indexed_find_list && other );
+
+			//[II] ITERATORS
+			const_iterator begin() const { return m_list.cbegin(); }
+			const_iterator end() const { return m_list.cend(); }
+			const_iterator cbegin() const { return m_list.cbegin(); }
+			const_iterator cend() const { return m_list.cend(); }
+
+			//[III] CAPACITY
+			int size() const { return m_list.size(); }
+			bool empty() const { return m_list.empty(); }
+
+			//[IV] MODIFIERS
+			const T & front() const { return m_list.front(); }
+			const T & back() const { return m_list.back(); }
+
+			void push_front( const T & value ){ emplace(cbegin(), value); }
+			void push_front( T && value ){ emplace(cbegin(), std::move(value)); }
+			void push_back( const T & value ){ emplace(cend(), value); }
+			void push_back( T && value ){ emplace(cend(), std::move(value)); }
+
+			template<typename... Args>
+			const T & emplace_front( Args &&... args ){ return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+			template<typename... Args>
+			const T & emplace_back( Args &&... args ){ return *emplace(cend(), std::forward<Args>(args)...); }
+
+			void pop_front(){ erase(cbegin()); }
+			void pop_back(){ erase(--cend()); }
+			void clear();
+
+			/* <! Builds a value in place before pos and indexes it.
+				@return The iterator to the new value.
+			*/
+			template<typename... Args>
+			const_iterator emplace( const_iterator pos, Args &&... args );
+
+			const_iterator insert( const_iterator pos, const T & value ){ return emplace(pos, value); }
+			const_iterator insert( const_iterator pos, T && value ){ return emplace(pos, std::move(value)); }
+
+			/* <! Removes the object at pos.
+				@return Iterator to the element after pos.
+			*/
+			const_iterator erase( const_iterator pos );
+
+			/* <! Removes the objects on the range [first; last).
+				@return Iterator to last.
+			*/
+			const_iterator erase( const_iterator first, const_iterator last );
+
+			/* <! Removes every element whose key equals key.
+				@return The number of elements removed.
+			*/
+			int erase( const key_type & key );
+
+			//[V] LOOKUP
+
+			/* <! Returns an element whose key equals key, or end(). With several, which one is unspecified. */
+			const_iterator find( const key_type & key ) const;
+
+			bool contains( const key_type & key ) const { return m_index.find(key) != m_index.end(); }
+
+			/* <! Returns the number of elements whose key equals key. */
+			int count( const key_type & key ) const { return int( m_index.count(key) ); }
+
+			/* <! Read-only access to the underlying list. */
+			const list_type & items() const { return m_list; }
+
+			//[VI] COMPARISONS
+			bool operator==( const indexed_find_list & rhs ) const { return m_list == rhs.m_list; }
+			bool operator!=( const indexed_find_list & rhs ) const { return m_list != rhs.m_list; }
+
+		private:
+			typedef std::pair<const key_type, const_iterator> entry_type;
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<entry_type> index_allocator_type;
+			typedef std::unordered_multimap<key_type, const_iterator, Hash, KeyEqual, index_allocator_type> index_type;
+
+			/* <! Indexes every element of m_list; the index must be empty. */
+			void build();
+
+			/* <! True if moving from into m_list hands its nodes over rather than rebuilding them. */
+			bool takes_nodes( const list_type & from ) const{
+				return std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+					m_list.get_allocator() == from.get_allocator();
+			}
+
+			/* <! Drops the index entry of the node at pos. */
+			void unindex( const_iterator pos );
+
+			list_type m_list;
+			index_type m_index;
+			KeyOf m_key;
+	};
+
+	//=======================================================================================
+
+	//SPECIAL MEMBERS
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::indexed_find_list( std::initializer_list<T> ilist ) : m_list(ilist){
+		build();
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	template<typename InputIt>
+	indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::indexed_find_list( InputIt first, InputIt last ) : m_list(first, last){
+		build();
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::indexed_find_list( list_type && items ) : m_list(std::move(items)){
+		build();
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::indexed_find_list( const indexed_find_list & other ) :
+		m_list(other.m_list), m_index(other.m_index.bucket_count(), other.m_index.hash_function(), other.m_index.key_eq()), m_key(other.m_key){
+		build();
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator> & indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::operator= ( const indexed_find_list & other ){
+		if(this == &other) return *this;
+
+		// Nodes from the allocator this list ends up with, as list assignment would pick it.
+		list_type items( std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value ?
+			other.m_list.get_allocator() : m_list.get_allocator() );
+		items.assign(other.m_list.cbegin(), other.m_list.cend());
+
+		KeyOf key(other.m_key);
+		index_type index(other.m_index.bucket_count(), other.m_index.hash_function(), other.m_index.key_eq());
+		index.reserve( items.size() );
+		for(auto i(items.cbegin()); i != items.cend(); ++i){
+			index.emplace( key(*i), i );
+		}
+
+		// Nothing below throws when the nodes change hands, the usual case.
+		m_key = std::move(key);
+		if(takes_nodes(items)){
+			m_list = std::move(items);
+			m_index = std::move(index);
+		}else{
+			m_index.clear();
+			m_list = std::move(items);
+			build();
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator> & indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::operator= ( indexed_find_list && other ){
+		if(this == &other) return *this;
+
+		m_key = std::move(other.m_key);
+		if(takes_nodes(other.m_list)){
+			m_list = std::move(other.m_list);
+			m_index = std::move(other.m_index);
+			other.m_index.clear();
+		}else{
+			m_index.clear();
+			other.m_index.clear();
+			m_list = std::move(other.m_list);
+			build();
+		}
+
+		return *this;
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	void indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::build(){
+		m_index.reserve( m_list.size() );
+		for(auto i(m_list.cbegin()); i != m_list.cend(); ++i){
+			m_index.emplace( m_key(*i), i );
+		}
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	void indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::unindex( const_iterator pos ){
+		auto range = m_index.equal_range( m_key(*pos) );
+		for(auto i(range.first); i != range.second; ++i){
+			if(i->second == pos){
+				m_index.erase(i);
+				return;
+			}
+		}
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	void indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::clear(){
+		m_index.clear();
+		m_list.clear();
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	template<typename... Args>
+	typename indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::const_iterator indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::emplace( const_iterator pos, Args &&... args ){
+		const_iterator temp = m_list.emplace(pos, std::forward<Args>(args)...);
+
+		try{
+			m_index.emplace( m_key(*temp), temp );
+		}catch(...){
+			m_list.erase(temp);
+			throw;
+		}
+
+		return temp;
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	typename indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::const_iterator indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::erase( const_iterator pos ){
+		if(pos == m_list.cend()) return pos;
+
+		unindex(pos);
+		return m_list.erase(pos);
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	typename indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::const_iterator indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::erase( const_iterator first, const_iterator last ){
+		for(auto i(first); i != last; ++i){
+			unindex(i);
+		}
+		return m_list.erase(first, last);
+	}
+
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	int indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::erase( const key_type & key ){
+		auto range = m_index.equal_range(key);
+		int count = 0;
+
+		for(auto i(range.first); i != range.second; ++i){
+			m_list.erase(i->second);
+			count++;
+		}
+		m_index.erase(range.first, range.second);
+
+		return count;
+	}
+
+	//=======================================================================================
+
+	//LOOKUP
+	template<typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+	typename indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::const_iterator indexed_find_list<T,KeyOf,Hash,KeyEqual,Allocator>::find( const key_type & key ) const{
+		auto i = m_index.find(key);
+		return (i == m_index.end()) ? m_list.cend() : i->second;
+	}
+}
+
+#endif
@@ -0,0 +1,593 @@
+#ifndef INDEXED_LIST_H
+#define INDEXED_LIST_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "node_pool.h"
+
+namespace ls{
+template<typename T, typename Allocator = pool_allocator<T> >
+
+	/* <! A double linked list that also threads its nodes through an order-statistic treap, keyed by
+		position. Every tree node counts the nodes below it, so at(i), iterator_at(i), index_of(it)
+		and insertion or removal at an index run in O(log n) expected time. Iteration follows the
+		list links and stays O(1) per step. Inserting or erasing by iterator relinks the neighbours
+		in O(1), and then restores the counts and the heap order along one path of the treap,
+		O(log n) expected.
+	*/
+	class indexed_list
+	{
+		private:
+			/* <! Contains nodes previous and next adresses. The sentinel is a bare NodeBase. */
+			struct NodeBase{
+				NodeBase *prev; //<! Pointer to the previous node in the list.
+				NodeBase *next; //<! Pointer to the next node in the list.
+			};
+
+			/* <! A node that carries data, linked in position order both in the list and in the treap. */
+			struct Node : NodeBase{
+				Node *parent;           //<! Parent in the treap; nullptr at the root.
+				Node *left;             //<! Nodes that come before, in the treap.
+				Node *right;            //<! Nodes that come after, in the treap.
+				int count;              //<! Nodes in the subtree rooted here, this one included.
+				std::uint32_t priority; //<! Heap key: parents have smaller priorities than children.
+				T data;                 //<! Data field
+			};
+
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_allocator_type;
+			typedef std::allocator_traits<node_allocator_type> node_traits;
+
+		public:
+			typedef Allocator allocator_type;
+
+			/* <! A simple const_iterator class. */
+			class const_iterator{
+				public:
+					typedef const T& const_reference;
+					typedef const T* const_pointer;
+					typedef std::ptrdiff_t difference_type;
+
+					/* <! Default const_iterator initializer. */
+					const_iterator() = default;
+
+					/* <! Default const_iterator deferencier.
+						@return value of it.
+					*/
+					const_reference operator*() const { return static_cast<Node*>(current)->data; }
+					const_pointer operator->() const { return std::addressof( static_cast<Node*>(current)->data ); }
+
+					const_iterator & operator++(){ current = current->next; return *this; }
+					const_iterator operator++(int){ const_iterator temp(*this); current = current->next; return temp; }
+					const_iterator & operator--(){ current = current->prev; return *this; }
+					const_iterator operator--(int){ const_iterator temp(*this); current = current->prev; return temp; }
+
+					bool operator==(const const_iterator &rhs) const { return current == rhs.current; }
+					bool operator!=(const const_iterator &rhs) const { return current != rhs.current; }
+
+				protected:
+					NodeBase *current = nullptr;
+					const_iterator(NodeBase *p) : current(p){ /*empty*/ }
+
+					friend class indexed_list;
+			};
+
+			class iterator : public const_iterator{
+				public:
+					typedef T& reference;
+					typedef T* pointer;
+
+					iterator() : const_iterator() { /*empty*/ }
+
+					reference operator*() const { return static_cast<Node*>(this->current)->data; }
+					pointer operator->() const { return std::addressof( static_cast<Node*>(this->current)->data ); }
+
+					iterator & operator++(){ const_iterator::operator++(); return *this; }
+					iterator operator++(int){ iterator temp(*this); const_iterator::operator++(); return temp; }
+					iterator & operator--(){ const_iterator::operator--(); return *this; }
+					iterator operator--(int){ iterator temp(*this); const_iterator::operator--(); return temp; }
+
+				protected:
+					iterator(NodeBase *p) : const_iterator(p){ /*empty*/ }
+					explicit iterator(const const_iterator &it) : const_iterator(it){ /*empty*/ }
+
+					friend class indexed_list;
+			};
+
+			// [I] SPECIAL MEMBERS
+			indexed_list() : indexed_list( Allocator() ){ /*empty*/ }
+
+			/* <! Constructs an empty list that allocates through alloc. */
+			explicit indexed_list( const Allocator & alloc );
+
+			/* <! Constructs the list with the contents of the range [first,last). */
+			template<typename InputIt>
+			indexed_list( InputIt first, InputIt last, const Allocator & alloc = Allocator() );
+
+			/* <! Constructs the list with the contents of the initializer list ilist. */
+			indexed_list( std::initializer_list<T> ilist, const Allocator & alloc = Allocator() );
+
+			indexed_list( const indexed_list & other );
+
+			/* <! Move constructs. Takes the nodes and the treap of other in O(1). */
+			indexed_list( indexed_list && other ) noexcept;
+
+			~indexed_list();
+
+			indexed_list & operator= ( const indexed_list & other );
+			/* <! Move assigns. Takes the nodes and the treap of other when the allocator propagates or
+				compares equal, otherwise moves the elements one by one into nodes of this list's allocator.
+			*/
+			indexed_list & operator= ( indexed_list && other ) noexcept( node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value );
+			indexed_list & operator= ( std::initializer_list<T> ilist );
+
+			allocator_type get_allocator() const { return allocator_type(m_alloc); }
+
+			//[II] ITERATORS
+			iterator begin(){ return iterator(m_sentinel.next); }
+			const_iterator begin() const { return cbegin(); }
+			const_iterator cbegin() const { return const_iterator(m_sentinel.next); }
+			iterator end(){ return iterator(&m_sentinel); }
+			const_iterator end() const { return cend(); }
+			const_iterator cend() const { return const_iterator(const_cast<NodeBase*>(&m_sentinel)); }
+
+			//[III] CAPACITY
+			int size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+
+			//[IV] MODIFIERS
+			void clear();
+
+			T & front(){ return static_cast<Node*>(m_sentinel.next)->data; }
+			const T & front() const { return static_cast<Node*>(m_sentinel.next)->data; }
+			T & back(){ return static_cast<Node*>(m_sentinel.prev)->data; }
+			const T & back() const { return static_cast<Node*>(m_sentinel.prev)->data; }
+
+			void push_front( const T & value ){ emplace(cbegin(), value); }
+			void push_front( T && value ){ emplace(cbegin(), std::move(value)); }
+			void push_back( const T & value ){ emplace(cend(), value); }
+			void push_back( T && value ){ emplace(cend(), std::move(value)); }
+
+			template<typename... Args>
+			T & emplace_front( Args &&... args ){ return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+			template<typename... Args>
+			T & emplace_back( Args &&... args ){ return *emplace(cend(), std::forward<Args>(args)...); }
+
+			void pop_front(){ erase(cbegin()); }
+			void pop_back(){ erase(const_iterator(m_sentinel.prev)); }
+
+			//[IV-a] MODIFIERS WITH ITERATORS
+
+			/* <! Builds a value in place before pos.
+				@return The iterator to the new value.
+			*/
+			template<typename... Args>
+			iterator emplace( const_iterator pos, Args &&... args );
+
+			iterator insert( const_iterator pos, const T & value ){ return emplace(pos, value); }
+			iterator insert( const_iterator pos, T && value ){ return emplace(pos, std::move(value)); }
+
+			/* <! Insert elements from the range [first; last) before pos.
+				@return The iterator to the first element added, or pos if the range is empty.
+			*/
+			template<typename InItr>
+			iterator insert( const_iterator pos, InItr first, InItr last );
+
+			/* <! Removes the object at pos.
+				@return Iterator to the element after pos.
+			*/
+			iterator erase( const_iterator pos );
+
+			/* <! Removes the objects on the range [first; last).
+				@return Iterator to last.
+			*/
+			iterator erase( const_iterator first, const_iterator last );
+
+			const_iterator find( const T & value ) const;
+
+			//[V] POSITIONAL ACCESS
+
+			/* <! Returns the element at index i.
+				@throw std::out_of_range if i is not in [0, size()).
+			*/
+			T & at( int i );
+			const T & at( int i ) const;
+
+			/* <! Returns the iterator to the element at index i, or end() when i == size(). */
+			iterator iterator_at( int i ){ return iterator( locate(i) ); }
+			const_iterator iterator_at( int i ) const { return const_iterator( locate(i) ); }
+
+			/* <! Returns the index of the element at pos, or size() for end(). */
+			int index_of( const_iterator pos ) const;
+
+			/* <! Returns the iterator count positions after first, in O(log n). */
+			iterator next( const_iterator first, int count ){ return iterator_at( index_of(first) + count ); }
+
+			/* <! Builds a value in place so that it ends up at index i, with 0 <= i <= size(). */
+			template<typename... Args>
+			iterator emplace_at( int i, Args &&... args ){ return emplace( const_iterator( locate(i) ), std::forward<Args>(args)... ); }
+
+			iterator insert_at( int i, const T & value ){ return emplace_at(i, value); }
+			iterator insert_at( int i, T && value ){ return emplace_at(i, std::move(value)); }
+
+			/* <! Removes the element at index i.
+				@return Iterator to the element that took its index.
+			*/
+			iterator erase_at( int i ){ return erase( const_iterator( locate(i) ) ); }
+
+			bool operator==( const indexed_list & rhs ) const;
+			bool operator!=( const indexed_list & rhs ) const { return !(*this == rhs); }
+
+		private:
+			static int count_of( const Node * n ){ return n ? n->count : 0; }
+
+			/* <! Recomputes the count of n from its children. */
+			static void update( Node * n ){ n->count = count_of(n->left) + count_of(n->right) + 1; }
+
+			/* <! Returns the node at index i, or the sentinel when i == size(). */
+			NodeBase * locate( int i ) const;
+
+			/* <! Lifts x above its parent, keeping the in-order sequence. */
+			void rotate_up( Node * x );
+
+			/* <! Hangs x, already in the list, into the treap as the in-order neighbour of its list links. */
+			void attach( Node * x );
+
+			/* <! Takes x out of the treap. Its list links are left alone. */
+			void detach( Node * x );
+
+			/* <! Next pseudo random priority (xorshift32). */
+			std::uint32_t draw(){
+				m_seed ^= m_seed << 13;
+				m_seed ^= m_seed >> 17;
+				m_seed ^= m_seed << 5;
+				return m_seed;
+			}
+
+			/* <! Takes the nodes of other, which is left empty. This list must be empty. */
+			void steal( indexed_list & other ) noexcept;
+
+			node_allocator_type m_alloc;
+			int m_size = 0;
+			NodeBase m_sentinel; //<! m_sentinel.next is the first node and m_sentinel.prev the last.
+			Node *m_root = nullptr;
+			std::uint32_t m_seed = 0x9e3779b9u;
+	};
+
+	//=======================================================================================
+
+	//SPECIAL MEMBERS
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator>::indexed_list( const Allocator & alloc ) : m_alloc(alloc){
+		m_sentinel.next = &m_sentinel;
+		m_sentinel.prev = &m_sentinel;
+	}
+
+	template<typename T, typename Allocator>
+	template<typename InputIt>
+	indexed_list<T,Allocator>::indexed_list( InputIt first, InputIt last, const Allocator & alloc ) : indexed_list(alloc){
+		for(; first != last; ++first){
+			emplace(cend(), *first);
+		}
+	}
+
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator>::indexed_list( std::initializer_list<T> ilist, const Allocator & alloc ) :
+		indexed_list(ilist.begin(), ilist.end(), alloc){ /*empty*/ }
+
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator>::indexed_list( const indexed_list & other ) :
+		indexed_list(other.cbegin(), other.cend(), node_traits::select_on_container_copy_construction(other.m_alloc)){ /*empty*/ }
+
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator>::indexed_list( indexed_list && other ) noexcept : indexed_list(Allocator(other.m_alloc)){
+		steal(other);
+	}
+
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator>::~indexed_list(){
+		clear();
+	}
+
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator> & indexed_list<T,Allocator>::operator= ( const indexed_list & other ){
+		if(this == &other) return *this;
+
+		clear();
+		if constexpr(node_traits::propagate_on_container_copy_assignment::value){
+			m_alloc = other.m_alloc;
+		}
+		for(auto i(other.cbegin()); i != other.cend(); ++i){
+			emplace(cend(), *i);
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator> & indexed_list<T,Allocator>::operator= ( indexed_list && other )
+		noexcept( node_traits::propagate_on_container_move_assignment::value || node_traits::is_always_equal::value ){
+		if(this == &other) return *this;
+
+		if(node_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc){
+			clear();
+			if constexpr(node_traits::propagate_on_container_move_assignment::value){
+				m_alloc = other.m_alloc;
+			}
+			steal(other);
+		}else{
+			// Nodes cannot change hands between unrelated allocators.
+			clear();
+			for(auto i(other.begin()); i != other.end(); ++i){
+				emplace(cend(), std::move(*i));
+			}
+			other.clear();
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	indexed_list<T,Allocator> & indexed_list<T,Allocator>::operator= ( std::initializer_list<T> ilist ){
+		clear();
+		for(auto &i : ilist){
+			emplace(cend(), i);
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	void indexed_list<T,Allocator>::steal( indexed_list & other ) noexcept{
+		if(other.m_size == 0) return;
+
+		m_sentinel.next = other.m_sentinel.next;
+		m_sentinel.prev = other.m_sentinel.prev;
+		m_sentinel.next->prev = &m_sentinel;
+		m_sentinel.prev->next = &m_sentinel;
+		m_size = other.m_size;
+		m_root = other.m_root;
+
+		other.m_sentinel.next = &other.m_sentinel;
+		other.m_sentinel.prev = &other.m_sentinel;
+		other.m_size = 0;
+		other.m_root = nullptr;
+	}
+
+	//=======================================================================================
+
+	//TREAP
+	template<typename T, typename Allocator>
+	typename indexed_list<T,Allocator>::NodeBase * indexed_list<T,Allocator>::locate( int i ) const{
+		if( i == m_size ) return const_cast<NodeBase*>(&m_sentinel);
+
+		Node *n = m_root;
+		while( n != nullptr ){
+			int left = count_of(n->left);
+			if( i < left ){
+				n = n->left;
+			}else if( i == left ){
+				return n;
+			}else{
+				i -= left + 1;
+				n = n->right;
+			}
+		}
+
+		return const_cast<NodeBase*>(&m_sentinel);
+	}
+
+	template<typename T, typename Allocator>
+	void indexed_list<T,Allocator>::rotate_up( Node * x ){
+		Node *p = x->parent;
+		Node *g = p->parent;
+
+		if( x == p->left ){
+			p->left = x->right;
+			if( p->left ) p->left->parent = p;
+			x->right = p;
+		}else{
+			p->right = x->left;
+			if( p->right ) p->right->parent = p;
+			x->left = p;
+		}
+
+		p->parent = x;
+		x->parent = g;
+		if( g == nullptr ){
+			m_root = x;
+		}else if( g->left == p ){
+			g->left = x;
+		}else{
+			g->right = x;
+		}
+
+		update(p);
+		update(x);
+	}
+
+	template<typename T, typename Allocator>
+	void indexed_list<T,Allocator>::attach( Node * x ){
+		x->left = nullptr;
+		x->right = nullptr;
+		x->count = 1;
+		x->priority = draw();
+
+		// The in-order successor has no left child, or else the predecessor has no right child.
+		if( m_root == nullptr ){
+			x->parent = nullptr;
+			m_root = x;
+			return;
+		}else if( x->next != &m_sentinel && static_cast<Node*>(x->next)->left == nullptr ){
+			x->parent = static_cast<Node*>(x->next);
+			x->parent->left = x;
+		}else{
+			x->parent = static_cast<Node*>(x->prev);
+			x->parent->right = x;
+		}
+
+		for( Node *p = x->parent; p != nullptr; p = p->parent ){
+			p->count++;
+		}
+
+		while( x->parent != nullptr && x->priority < x->parent->priority ){
+			rotate_up(x);
+		}
+	}
+
+	template<typename T, typename Allocator>
+	void indexed_list<T,Allocator>::detach( Node * x ){
+		// Sink x until it has one child at most, then splice it out.
+		while( x->left != nullptr && x->right != nullptr ){
+			rotate_up( x->left->priority < x->right->priority ? x->left : x->right );
+		}
+
+		Node *child = x->left ? x->left : x->right;
+		Node *p = x->parent;
+		if( child ) child->parent = p;
+
+		if( p == nullptr ){
+			m_root = child;
+		}else if( p->left == x ){
+			p->left = child;
+		}else{
+			p->right = child;
+		}
+
+		for(; p != nullptr; p = p->parent ){
+			p->count--;
+		}
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS
+	template<typename T, typename Allocator>
+	void indexed_list<T,Allocator>::clear(){
+		NodeBase *n = m_sentinel.next;
+
+		while( n != &m_sentinel ){
+			Node *temp = static_cast<Node*>(n);
+			n = n->next;
+			node_traits::destroy(m_alloc, std::addressof(temp->data));
+			node_traits::deallocate(m_alloc, temp, 1);
+		}
+
+		m_sentinel.next = &m_sentinel;
+		m_sentinel.prev = &m_sentinel;
+		m_size = 0;
+		m_root = nullptr;
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	typename indexed_list<T,Allocator>::iterator indexed_list<T,Allocator>::emplace( const_iterator pos, Args &&... args ){
+		Node *temp = node_traits::allocate(m_alloc, 1);
+
+		try{
+			node_traits::construct(m_alloc, std::addressof(temp->data), std::forward<Args>(args)...);
+		}catch(...){
+			node_traits::deallocate(m_alloc, temp, 1);
+			throw;
+		}
+
+		temp->next = pos.current;
+		temp->prev = pos.current->prev;
+		temp->prev->next = temp;
+		pos.current->prev = temp;
+		attach(temp);
+		m_size++;
+
+		return iterator(temp);
+	}
+
+	template<typename T, typename Allocator>
+	template<typename InItr>
+	typename indexed_list<T,Allocator>::iterator indexed_list<T,Allocator>::insert( const_iterator pos, InItr first, InItr last ){
+		if( first == last ) return iterator(pos);
+
+		iterator temp = emplace(pos, *first);
+		for( ++first; first != last; ++first ){
+			emplace(pos, *first);
+		}
+		return temp;
+	}
+
+	template<typename T, typename Allocator>
+	typename indexed_list<T,Allocator>::iterator indexed_list<T,Allocator>::erase( const_iterator pos ){
+		if( pos.current == &m_sentinel ) return end();
+
+		Node *temp = static_cast<Node*>(pos.current);
+		NodeBase *next = temp->next;
+
+		detach(temp);
+		temp->prev->next = next;
+		next->prev = temp->prev;
+		m_size--;
+
+		node_traits::destroy(m_alloc, std::addressof(temp->data));
+		node_traits::deallocate(m_alloc, temp, 1);
+		return iterator(next);
+	}
+
+	template<typename T, typename Allocator>
+	typename indexed_list<T,Allocator>::iterator indexed_list<T,Allocator>::erase( const_iterator first, const_iterator last ){
+		while( first != last ){
+			first = erase(first);
+		}
+		return iterator(last);
+	}
+
+	template<typename T, typename Allocator>
+	typename indexed_list<T,Allocator>::const_iterator indexed_list<T,Allocator>::find( const T & value ) const{
+		for(auto i(cbegin()); i != cend(); ++i){
+			if( *i == value ) return i;
+		}
+		return cend();
+	}
+
+	//=======================================================================================
+
+	//POSITIONAL ACCESS
+	template<typename T, typename Allocator>
+	T & indexed_list<T,Allocator>::at( int i ){
+		if( i < 0 || i >= m_size ) throw std::out_of_range("ls::indexed_list::at");
+		return static_cast<Node*>( locate(i) )->data;
+	}
+
+	template<typename T, typename Allocator>
+	const T & indexed_list<T,Allocator>::at( int i ) const{
+		if( i < 0 || i >= m_size ) throw std::out_of_range("ls::indexed_list::at");
+		return static_cast<Node*>( locate(i) )->data;
+	}
+
+	template<typename T, typename Allocator>
+	int indexed_list<T,Allocator>::index_of( const_iterator pos ) const{
+		if( pos.current == &m_sentinel ) return m_size;
+
+		// Climb to the root, adding what lies left of every step up from a right child.
+		const Node *n = static_cast<const Node*>(pos.current);
+		int index = count_of(n->left);
+		for(; n->parent != nullptr; n = n->parent ){
+			if( n == n->parent->right ){
+				index += count_of(n->parent->left) + 1;
+			}
+		}
+		return index;
+	}
+
+	template<typename T, typename Allocator>
+	bool indexed_list<T,Allocator>::operator==( const indexed_list & rhs ) const{
+		if( m_size != rhs.m_size ) return false;
+
+		auto j(rhs.cbegin());
+		for( auto i(cbegin()); i != cend(); ++i, ++j ){
+			if( !(*i == *j) ) return false;
+		}
+		return true;
+	}
+}
+
+#endif
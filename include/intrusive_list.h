@@ -0,0 +1,311 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace ls{
+	/* <! Links embedded in a user object so that it can sit in an intrusive_list.
+		Both links are null while the object is in no list.
+	*/
+	struct list_hook{
+		list_hook *prev = nullptr; //<! Pointer to the previous hook in the list.
+		list_hook *next = nullptr; //<! Pointer to the next hook in the list.
+		void *owner = nullptr;     //<! The object holding the hook, set when it is linked.
+
+		list_hook() = default;
+		// A copied object starts out of any list.
+		list_hook( const list_hook & ) noexcept { /*empty*/ }
+		list_hook & operator= ( const list_hook & ) noexcept { return *this; }
+
+		/* <! True while the object is in a list. */
+		bool is_linked() const noexcept { return next != nullptr; }
+	};
+
+template<typename T, list_hook T::*Hook>
+
+	/* <! Double linked list of objects owned by someone else. The links live in a list_hook member
+		of T, so linking never allocates nor copies, and an object can be unlinked in O(1) from a
+		reference to it. An object is in at most one list per hook, and must stay alive, and not move,
+		while it is linked. Destroying or clearing the list only unlinks the objects.
+	*/
+	class intrusive_list
+	{
+		public:
+			typedef T value_type;
+
+			/* <! A simple const_iterator class. */
+			class const_iterator{
+				public:
+					typedef const T& const_reference;
+					typedef const T* const_pointer;
+					typedef std::ptrdiff_t difference_type;
+
+					const_iterator() = default;
+
+					const_reference operator*() const { return *intrusive_list::owner(current); }
+					const_pointer operator->() const { return intrusive_list::owner(current); }
+
+					const_iterator & operator++(){ current = current->next; return *this; }
+					const_iterator operator++(int){ const_iterator temp(*this); current = current->next; return temp; }
+					const_iterator & operator--(){ current = current->prev; return *this; }
+					const_iterator operator--(int){ const_iterator temp(*this); current = current->prev; return temp; }
+
+					bool operator==(const const_iterator &rhs) const { return current == rhs.current; }
+					bool operator!=(const const_iterator &rhs) const { return current != rhs.current; }
+
+				protected:
+					list_hook *current = nullptr;
+					const_iterator(list_hook *p) : current(p){ /*empty*/ }
+
+					friend class intrusive_list;
+			};
+
+			class iterator : public const_iterator{
+				public:
+					typedef T& reference;
+					typedef T* pointer;
+
+					iterator() : const_iterator() { /*empty*/ }
+
+					reference operator*() const { return *intrusive_list::owner(this->current); }
+					pointer operator->() const { return intrusive_list::owner(this->current); }
+
+					iterator & operator++(){ const_iterator::operator++(); return *this; }
+					iterator operator++(int){ iterator temp(*this); const_iterator::operator++(); return temp; }
+					iterator & operator--(){ const_iterator::operator--(); return *this; }
+					iterator operator--(int){ iterator temp(*this); const_iterator::operator--(); return temp; }
+
+				protected:
+					iterator(list_hook *p) : const_iterator(p){ /*empty*/ }
+
+					friend class intrusive_list;
+			};
+
+			// [I] SPECIAL MEMBERS
+			intrusive_list() noexcept { init(); }
+			intrusive_list( const intrusive_list & ) = delete;
+			intrusive_list & operator= ( const intrusive_list & ) = delete;
+
+			/* <! Takes the objects of other, which is left empty. */
+			intrusive_list( intrusive_list && other ) noexcept { init(); splice(cend(), other); }
+			intrusive_list & operator= ( intrusive_list && other ) noexcept;
+
+			/* <! Unlinks every object. */
+			~intrusive_list(){ clear(); }
+
+			//[II] ITERATORS
+			iterator begin() noexcept { return iterator(m_sentinel.next); }
+			const_iterator begin() const noexcept { return cbegin(); }
+			const_iterator cbegin() const noexcept { return const_iterator(m_sentinel.next); }
+			iterator end() noexcept { return iterator(&m_sentinel); }
+			const_iterator end() const noexcept { return cend(); }
+			const_iterator cend() const noexcept { return const_iterator(const_cast<list_hook*>(&m_sentinel)); }
+
+			/* <! Returns the iterator to value, which must be in this list. O(1). */
+			iterator iterator_to( T & value ) noexcept { return iterator(&(value.*Hook)); }
+			const_iterator iterator_to( const T & value ) const noexcept { return const_iterator(const_cast<list_hook*>(&(value.*Hook))); }
+
+			//[III] CAPACITY
+			int size() const noexcept { return m_size; }
+			bool empty() const noexcept { return m_size == 0; }
+
+			//[IV] MODIFIERS
+			T & front() noexcept { return *owner(m_sentinel.next); }
+			const T & front() const noexcept { return *owner(m_sentinel.next); }
+			T & back() noexcept { return *owner(m_sentinel.prev); }
+			const T & back() const noexcept { return *owner(m_sentinel.prev); }
+
+			/* <! Links value at the front. value must not be in a list. */
+			void push_front( T & value ) noexcept { insert(cbegin(), value); }
+
+			/* <! Links value at the back. value must not be in a list. */
+			void push_back( T & value ) noexcept { insert(cend(), value); }
+
+			/* <! Unlinks the first object. */
+			void pop_front() noexcept { erase(cbegin()); }
+
+			/* <! Unlinks the last object. */
+			void pop_back() noexcept { erase(const_iterator(m_sentinel.prev)); }
+
+			/* <! Unlinks every object. */
+			void clear() noexcept;
+
+			//[IV-a] MODIFIERS WITH ITERATORS
+
+			/* <! Links value before pos. value must not be in a list.
+				@return The iterator to value.
+			*/
+			iterator insert( const_iterator pos, T & value ) noexcept;
+
+			/* <! Unlinks the object at pos.
+				@return Iterator to the object after pos.
+			*/
+			iterator erase( const_iterator pos ) noexcept;
+
+			/* <! Unlinks value, which must be in this list, in O(1).
+				@return Iterator to the object after value.
+			*/
+			iterator erase( T & value ) noexcept { return erase(iterator_to(value)); }
+
+			/* <! Unlinks the objects on the range [first; last).
+				@return Iterator to last.
+			*/
+			iterator erase( const_iterator first, const_iterator last ) noexcept;
+
+			//[V] OPERATIONS
+
+			/* <! Moves every object of other before pos, in O(1). */
+			void splice( const_iterator pos, intrusive_list & other ) noexcept;
+
+			/* <! Moves the object at it, from other, before pos, in O(1). */
+			void splice( const_iterator pos, intrusive_list & other, const_iterator it ) noexcept;
+
+			/* <! Moves the objects in [first; last), from other, before pos.
+				The relinking is O(1); counting the range is linear unless other is this list.
+			*/
+			void splice( const_iterator pos, intrusive_list & other, const_iterator first, const_iterator last ) noexcept;
+
+		private:
+			/* <! Returns the object that holds hook h, as recorded by insert. */
+			static T * owner( list_hook * h ) noexcept { return static_cast<T*>(h->owner); }
+
+			/* <! Makes the list empty by linking the sentinel to itself. Does not unlink anything. */
+			void init() noexcept;
+
+			/* <! Moves the hooks in [first; last) before pos. The sizes are left to the caller. */
+			static void transfer( list_hook * pos, list_hook * first, list_hook * last ) noexcept;
+
+			list_hook m_sentinel; //<! m_sentinel.next is the first hook and m_sentinel.prev the last.
+			int m_size;
+	};
+
+	//=======================================================================================
+
+	template<typename T, list_hook T::*Hook>
+	void intrusive_list<T,Hook>::init() noexcept{
+		m_sentinel.next = &m_sentinel;
+		m_sentinel.prev = &m_sentinel;
+		m_size = 0;
+	}
+
+	template<typename T, list_hook T::*Hook>
+	intrusive_list<T,Hook> & intrusive_list<T,Hook>::operator= ( intrusive_list && other ) noexcept{
+		if(this == &other) return *this;
+
+		clear();
+		splice(cend(), other);
+		return *this;
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS
+	template<typename T, list_hook T::*Hook>
+	void intrusive_list<T,Hook>::clear() noexcept{
+		list_hook *h = m_sentinel.next;
+
+		while(h != &m_sentinel){
+			list_hook *next = h->next;
+			h->prev = nullptr;
+			h->next = nullptr;
+			h = next;
+		}
+
+		init();
+	}
+
+	template<typename T, list_hook T::*Hook>
+	typename intrusive_list<T,Hook>::iterator intrusive_list<T,Hook>::insert( const_iterator pos, T & value ) noexcept{
+		list_hook *h = &(value.*Hook);
+
+		h->owner = std::addressof(value);
+		h->next = pos.current;
+		h->prev = pos.current->prev;
+		pos.current->prev->next = h;
+		pos.current->prev = h;
+		m_size++;
+
+		return iterator(h);
+	}
+
+	template<typename T, list_hook T::*Hook>
+	typename intrusive_list<T,Hook>::iterator intrusive_list<T,Hook>::erase( const_iterator pos ) noexcept{
+		list_hook *h = pos.current;
+		if(h == &m_sentinel) return end();
+
+		list_hook *next = h->next;
+		h->prev->next = next;
+		next->prev = h->prev;
+		h->prev = nullptr;
+		h->next = nullptr;
+		m_size--;
+
+		return iterator(next);
+	}
+
+	template<typename T, list_hook T::*Hook>
+	typename intrusive_list<T,Hook>::iterator intrusive_list<T,Hook>::erase( const_iterator first, const_iterator last ) noexcept{
+		while(first != last){
+			first = erase(first);
+		}
+		return iterator(last.current);
+	}
+
+	//=======================================================================================
+
+	//OPERATIONS
+	template<typename T, list_hook T::*Hook>
+	void intrusive_list<T,Hook>::transfer( list_hook * pos, list_hook * first, list_hook * last ) noexcept{
+		if(first == last) return;
+
+		list_hook *last_in = last->prev;
+
+		first->prev->next = last;
+		last->prev = first->prev;
+
+		list_hook *before = pos->prev;
+		before->next = first;
+		first->prev = before;
+		last_in->next = pos;
+		pos->prev = last_in;
+	}
+
+	template<typename T, list_hook T::*Hook>
+	void intrusive_list<T,Hook>::splice( const_iterator pos, intrusive_list & other ) noexcept{
+		if(this == &other || other.m_size == 0) return;
+
+		transfer(pos.current, other.m_sentinel.next, &other.m_sentinel);
+		m_size += other.m_size;
+		other.init();
+	}
+
+	template<typename T, list_hook T::*Hook>
+	void intrusive_list<T,Hook>::splice( const_iterator pos, intrusive_list & other, const_iterator it ) noexcept{
+		if(pos.current == it.current || pos.current == it.current->next) return;
+
+		transfer(pos.current, it.current, it.current->next);
+		m_size++;
+		other.m_size--;
+	}
+
+	template<typename T, list_hook T::*Hook>
+	void intrusive_list<T,Hook>::splice( const_iterator pos, intrusive_list & other, const_iterator first, const_iterator last ) noexcept{
+		if(first == last) return;
+
+		if(this != &other){
+			int count = 0;
+			for(list_hook *temp = first.current; temp != last.current; temp = temp->next){
+				count++;
+			}
+			m_size += count;
+			other.m_size -= count;
+		}
+
+		transfer(pos.current, first.current, last.current);
+	}
+}
+
+#endif
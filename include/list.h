@@ -1,31 +1,59 @@
 #ifndef LIST_H
 #define LIST_H
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <functional>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __cpp_impl_three_way_comparison >= 201907L && __cpp_lib_three_way_comparison >= 201907L
+#include <compare>
+#endif
+
+#include "list_stats.h"
+#include "node_pool.h"
 
 using size_type = size_t;
 
 namespace ls{
-template<typename T>
+	namespace parallel{
+		/* <! Sorts an ls::list on a thread pool; defined in list_parallel.h. */
+		struct chain_sorter;
+	}
+
+template<typename T, typename Allocator = pool_allocator<T>, typename Stats = no_stats >
 	
-	/* <! Consists in the implementation of a double linked list using classes. */
+	/* <! Consists in the implementation of a double linked list using classes.
+		Every node is obtained from Allocator, rebound to the node type.
+		Stats is told of every allocation, free, traversal step and find: no_stats records nothing,
+		counting_stats counts per list and for the whole process (see list_stats.h).
+	*/
 	class list
 	{
 		private:
-			/* <! Contains nodes previous, next adresses and it`s data. */
-			struct Node{
-				T data;     //<! Data field
-				Node *prev; //<! Pointer to the previous node in the list.
-				Node *next; //<! Pointer to the next node in the list.
+			/* <! Contains nodes previous and next adresses. The sentinel is a bare NodeBase. */
+			struct NodeBase{
+				NodeBase *prev; //<! Pointer to the previous node in the list.
+				NodeBase *next; //<! Pointer to the next node in the list.
+			};
 
-				// <! basic constructor
-				Node(const T & d = T(), Node * p = nullptr, Node * n = nullptr ):
-				data(d),prev(p),next(n){ /*empty*/ }
+			/* <! A node that carries data. The data is built in place by the allocator. */
+			struct Node : NodeBase{
+				T data;     //<! Data field
 			};
 
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_allocator_type;
+			typedef std::allocator_traits<node_allocator_type> node_traits;
+
 		public:
+			typedef Allocator allocator_type;
+
 			/* <! A simple const_iterator class. */
 			class const_iterator{
 				public:
@@ -66,14 +94,14 @@ template<typename T>
 					*/
 					const_iterator & operator+(int add);
 					/* <! Overload on the it = rhs operator. */
-					const_iterator* operator=(const const_iterator &rhs);
+					const_iterator & operator=(const const_iterator &rhs);
 					/* <! Overload on the it - sub operator. 
 						@param sub int value.
 						@return const_iterator in new position.
 					*/
 					const_iterator & operator-(int sub);
 
-					pointer operator->(){ return current; }
+					pointer operator->(){ return static_cast<pointer>(current); }
 
 					/* <! Overload on the it == operator. 
 						@param rhs other const_iterator.
@@ -88,10 +116,10 @@ template<typename T>
 					bool operator!= (const const_iterator &rhs) const;
 
 				protected:
-					pointer current;
-					const_iterator(Node *p):current(p){ /*empty*/ };
+					NodeBase *current;
+					const_iterator(NodeBase *p):current(p){ /*empty*/ };
 
-					friend class list<T>;
+					friend class list<T,Allocator,Stats>;
 			};
 
 			class iterator : public const_iterator{
@@ -150,7 +178,7 @@ template<typename T>
 						@return iterator in new position.
 					*/
 					iterator operator--(int);
-					pointer operator->(){return this->current;}
+					pointer operator->(){return static_cast<pointer>(this->current);}
 
 					/* <! Overload on the it == operator. 
 						@param rhs other iterator.
@@ -165,47 +193,75 @@ template<typename T>
 					bool operator!= (const iterator &rhs) const;
 
 				protected:
-					iterator (Node *p) : const_iterator(p){ /*empty*/ };
+					iterator (NodeBase *p) : const_iterator(p){ /*empty*/ };
 
-					friend class list<T>;
+					friend class list<T,Allocator,Stats>;
 			};
 
 			// [I] SPECIAL MEMBERS
 			list();
+
+			/* <! Constructs an empty list that allocates through alloc.
+				@param alloc The allocator.
+			*/
+			explicit list( const Allocator & alloc );
 			
 			/* <! Constructs the list with default inserted instances.
 				@param cont of the tipe size_type.
+				@param alloc The allocator.
 			*/
-			explicit list(size_type cont);
+			explicit list(size_type cont, const Allocator & alloc = Allocator());
 
 			/* <! constructs the list with the contents of the range [first,last).
 				@param first pointer first the range.
 				@param last The pointer last the range.
+				@param alloc The allocator.
 			*/
 			template<typename InputIt>
-			list( InputIt, InputIt );
+			list( InputIt, InputIt, const Allocator & alloc = Allocator() );
 
 			/* <! Copy constructs. Constructs the list with the deep copy of other.
 				@param other The other list.
 			*/
 			list( const list & );
 
+			/* <! Copy constructs with the given allocator.
+				@param other The other list.
+				@param alloc The allocator.
+			*/
+			list( const list &, const Allocator & alloc );
+
+			/* <! Move constructs. Takes the nodes of other in O(1), without allocating; other is left empty.
+				@param other The other list.
+			*/
+			list( list && ) noexcept;
+
 			/* <! Cosntructs the list with the contents of the initializer list ilist. */
-			list( std::initializer_list<T> );
+			list( std::initializer_list<T>, const Allocator & alloc = Allocator() );
 
 			/* <! Destructs the list. */
 			~list();
 
-			/* <! Copy assigment operator. 
+			/* <! Copy assigment operator. Overwrites the elements already in place, allocates nodes
+				only for the elements beyond them and frees only the nodes left over.
 				@param other The other operator the type list.
 			*/
 			list & operator= ( const list & );
 
-			/* <! Replaces the contents with those identified by initializer list.
+			/* <! Move assigment operator. Takes the nodes of other, which is left empty.
+				Elements are moved one by one only when the allocators differ and do not propagate.
+				@param other The other list.
+			*/
+			list & operator= ( list && );
+
+			/* <! Replaces the contents with those identified by initializer list, reusing the nodes in place.
 				@param ilist.
 			*/ 
 			list & operator= ( std::initializer_list<T> );
 
+			/* <! Returns a copy of the allocator. */
+			allocator_type get_allocator() const;
+
 			//[II] ITERATORS
 			/* <! A normal iterator to begin of the list. 
 				@return A iterator with the begin position.
@@ -252,11 +308,35 @@ template<typename T>
 			*/
 			void push_front ( const T & value );
 
+			/* <! Add a value to the front of the list, moving it into the node.
+				@param T&& value : value to be added to the list.
+			*/
+			void push_front ( T && value );
+
 			/* <! Add a value to the end of the list.
 				@param const T& value : Value to be added to the list.
 			*/
 			void push_back (const T & value );
 
+			/* <! Add a value to the end of the list, moving it into the node.
+				@param T&& value : Value to be added to the list.
+			*/
+			void push_back ( T && value );
+
+			/* <! Builds a value in place at the front of the list.
+				@param args Arguments forwarded to the constructor of T.
+				@return The new element.
+			*/
+			template<typename... Args>
+			T & emplace_front( Args &&... args );
+
+			/* <! Builds a value in place at the end of the list.
+				@param args Arguments forwarded to the constructor of T.
+				@return The new element.
+			*/
+			template<typename... Args>
+			T & emplace_back( Args &&... args );
+
 			/* <! Remove the Object at the begin of the list. */
 			void pop_front ();
 
@@ -271,6 +351,8 @@ template<typename T>
 			//[IV-a] MODIFIERS WITH ITERATORS
 
 			/* <! Replaces the contents of the list with copies of the elements in the range [first,last).
+				Existing elements are assigned over, so refreshing a list from one of similar size
+				allocates and frees only the difference.
 				@param InItr first : Pointer to the frist of the range.
 				@param InItr last : Pointer to the last of the range.
 			*/
@@ -289,19 +371,36 @@ template<typename T>
 			*/
 			iterator insert( const_iterator itr, const T & value );
 
+			/* <! Adds a value into the list before the position given, moving it into the node.
+				@param const_iterator itr : Constant iterator with the position.
+				@param T&& value : The value to be added to the list.
+				@return The iterator to the new value.
+			*/
+			iterator insert( const_iterator itr, T && value );
+
+			/* <! Builds a value in place before the position given.
+				@param const_iterator pos : Constant iterator with the position.
+				@param args Arguments forwarded to the constructor of T.
+				@return The iterator to the new value.
+			*/
+			template<typename... Args>
+			iterator emplace( const_iterator pos, Args &&... args );
+
 			/* <! Insert elements from the range [first; last) before position given.
-				@param iterator pos : Iterator with the position.
+				The new nodes are built as a detached chain and linked in at once, so the list
+				is left untouched if building an element throws.
+				@param const_iterator pos : Constant iterator with the position.
 				@param InItr first : Pointer to the first of the range.
 				@param InItr last : Pointer to the last of the range.
-				@return The iterator with the position after the ranger add.
+				@return The iterator to the first element added, or pos if the range is empty.
 			*/
 			template<typename InItr>
-			iterator insert( iterator pos,InItr first, InItr last );
+			iterator insert( const_iterator pos,InItr first, InItr last );
 
 			/* <! Insert elements from the initializer list before the position give.
 				@param const_iterator pos : Constant iterator with the positon.
 				@param std::initializer_list ilist : initializer list to be added.
-				@return The iterator with the position after the initializer list.
+				@return The iterator to the first element added, or pos if the list is empty.
 			*/
 			iterator insert( const_iterator pos, std::initializer_list<T> ilist );
 
@@ -312,387 +411,678 @@ template<typename T>
 			iterator erase( const_iterator itr );
 
 			/* <! Removes the objects on the range [first; last).
-				@param iterator first : iterator to the first of the range.
-				@param iterator last : iterator to the last of the range.
-				@return iterator before position first.
+				The range is unlinked in O(1) and its nodes are then freed in one sweep.
+				@param const_iterator first : iterator to the first of the range.
+				@param const_iterator last : iterator to the last of the range.
+				@return iterator to last.
 			*/
-			iterator erase( iterator first, iterator last );
+			iterator erase( const_iterator first, const_iterator last );
 
 			/* <! Search for a value in the list.
 				@param const T& value : Object to be searched for.
 				@return The constant iterator in the position of the object. Return the position end if the object is not in the list.
 			*/
 			const_iterator find( const T & value ) const; 
+
+			/* <! Returns the iterator value positions after first. Starts from the finger when first is
+				the head or the last position reached, so it walks the shortest way there.
+			*/
 			iterator next(iterator, const T & value);
 
-			bool operator==(const list &rhs);
-			bool operator!=(const list &rhs);
+			/* <! Returns the iterator to the element at index, or end() when index == size().
+				Walks from whichever of the head, the tail or the last position reached is closest,
+				so a sequential scan (index, index+1, ...) costs O(1) per step.
+				Only the non-const overload moves the cached position; the const one reads it and leaves it,
+				so concurrent readers may share a list.
+				@param int index : Position in [0; size()].
+			*/
+			iterator advance_to( int index );
+			const_iterator advance_to( int index ) const;
+
+			//[V] OPERATIONS
+			// None of these allocate or copy T: nodes are only relinked. Lists that exchange
+			// nodes must have allocators that compare equal.
+
+			/* <! Moves every element of other before pos, in O(1).
+				@param const_iterator pos : Constant iterator with the position.
+				@param list& other : The list to take the elements from; left empty.
+			*/
+			void splice( const_iterator pos, list & other );
+
+			/* <! Moves every element of other before pos, in O(1). */
+			void splice( const_iterator pos, list && other );
+
+			/* <! Moves the element at it, from other, before pos, in O(1).
+				@param const_iterator pos : Constant iterator with the position.
+				@param list& other : The list that owns it; may be this list.
+				@param const_iterator it : The element to move.
+			*/
+			void splice( const_iterator pos, list & other, const_iterator it );
+
+			/* <! Moves the elements in [first; last), from other, before pos.
+				The relinking is O(1); counting the range is linear unless other is this list.
+				@param const_iterator pos : Constant iterator with the position.
+				@param list& other : The list that owns the range; may be this list if pos is outside it.
+				@param const_iterator first : The first element of the range.
+				@param const_iterator last : One past the last element of the range.
+			*/
+			void splice( const_iterator pos, list & other, const_iterator first, const_iterator last );
+
+			/* <! Cuts the list in two at pos.
+				Costs O(min(k, n-k)) steps to count the shorter part, where k is the index of pos.
+				@param const_iterator pos : The first element of the second part.
+				@return A list with the elements in [pos; end()); this list keeps [begin(); pos).
+			*/
+			list split_at( const_iterator pos );
+
+			/* <! Merges the sorted list other into this sorted list. Stable; other is left empty.
+				@param list& other : The list to merge.
+			*/
+			void merge( list & other );
+
+			/* <! Merges the sorted list other into this sorted list, ordered by comp. */
+			template<typename Compare>
+			void merge( list & other, Compare comp );
+
+			/* <! Sorts the list with a stable bottom-up merge sort. O(n log n), no extra memory. */
+			void sort();
 
-			friend std::ostream& operator<<(std::ostream &os_,const list<T> &v);		
+			/* <! Sorts the list by comp with a stable bottom-up merge sort. */
+			template<typename Compare>
+			void sort( Compare comp );
+
+			/* <! Reverses the order of the elements. */
+			void reverse() noexcept;
+
+			//[V-a] LOCALITY
+
+			/* <! Moves the elements into fresh nodes laid out in iteration order, then frees the old nodes.
+				With pool_allocator the fresh nodes are one run of adjacent slots, so a scan walks memory
+				forward without gaps. Other allocators are asked for every node first, and the nodes are
+				handed out by increasing address, which is only as contiguous as the allocator makes them.
+				Elements are moved with move_if_noexcept; if building one throws, the list is left as it was.
+				Invalidates the iterators and references to the elements moved.
+			*/
+			void compact(){ compact(cbegin(), m_size); }
+
+			/* <! Incremental compact(): moves at most count elements, starting at first.
+				@return Iterator to the element after the last one moved, to resume from on the next call.
+			*/
+			iterator compact( const_iterator first, int count );
+
+			/* <! Average address distance between neighbouring nodes, in node sizes. About 1 for a freshly
+				built or compacted list; grows as insertions and erasures scatter the nodes. 0 below two elements.
+			*/
+			double fragmentation() const noexcept;
+
+			//[VI] COMPARISONS
+			// Single pass over both lists, stopping at the first difference.
+
+			/* <! Return True if both lists have the same elements in the same order. */
+			bool operator==(const list &rhs) const;
+			bool operator!=(const list &rhs) const;
+
+			/* <! Lexicographical comparison of the elements, with T's operator<. */
+			bool operator<(const list &rhs) const;
+			bool operator>(const list &rhs) const;
+			bool operator<=(const list &rhs) const;
+			bool operator>=(const list &rhs) const;
+
+#if __cpp_impl_three_way_comparison >= 201907L && __cpp_lib_three_way_comparison >= 201907L
+			/* <! Lexicographical three-way comparison of the elements. Only for T with <=>. */
+			template<typename U = T>
+			std::compare_three_way_result_t<U> operator<=>(const list &rhs) const;
+#endif
+
+			//[VII] STATS
+
+			/* <! The counters of this list; see list_stats.h. Empty with no_stats. */
+			const Stats & stats() const noexcept { return m_stats; }
 
 		private:
+			/* <! Allocates a node and builds its data through the allocator.
+				@param p Previous node.
+				@param n Next node.
+				@param args Arguments forwarded to the constructor of T.
+				@return The new node.
+			*/
+			template<typename... Args>
+			Node * create_node( NodeBase * p, NodeBase * n, Args &&... args );
+
+			/* <! Destroys a node and gives its memory back to the allocator. */
+			void destroy_node( NodeBase * n );
+
+			/* <! Makes the list empty by linking the sentinel to itself. Does not free anything. */
+			void init() noexcept;
+
+			/* <! Destroys every node. */
+			void release();
+
+			/* <! Builds a chain of nodes, linked both ways, from the range [first; last).
+				Nothing is leaked if building an element throws.
+				@param tail Receives the last node of the chain, or nullptr for an empty range.
+				@param count Receives the number of nodes.
+				@return The first node, or nullptr for an empty range.
+			*/
+			template<typename InItr>
+			Node * create_chain( InItr first, InItr last, NodeBase *& tail, int & count );
+
+			/* <! Destroys the nodes in [first; last), following next.
+				@return The number of nodes destroyed.
+			*/
+			int destroy_chain( NodeBase * first, NodeBase * last );
+
+			/* <! Takes the nodes of other, which is left empty. This list must be empty. */
+			void steal( list & other ) noexcept;
+
+			/* <! Moves the nodes in [first; last) before pos. The sizes are left to the caller. */
+			static void transfer( NodeBase * pos, NodeBase * first, NodeBase * last ) noexcept;
+
+			/* <! Merges two null-terminated chains linked only through next. Stable.
+				@return The head of the merged chain.
+			*/
+			template<typename Compare>
+			static NodeBase * merge_chains( NodeBase * a, NodeBase * b, Compare & comp );
+
+			/* <! Sorts a null-terminated chain linked only through next. Stable.
+				@return The head of the sorted chain.
+			*/
+			template<typename Compare>
+			static NodeBase * sort_chain( NodeBase * first, Compare & comp );
+
+			/* <! Hangs a null-terminated chain linked only through next from the sentinel,
+				restoring the prev pointers. The size is left to the caller.
+			*/
+			void relink( NodeBase * first ) noexcept;
+
+			// Cuts, sorts and relinks the chain for parallel::sort.
+			friend struct parallel::chain_sorter;
+
+			/* <! Returns the node at index, or the sentinel for index == size(). Reads the finger but does
+				not move it, so const lookups write nothing but the stats.
+			*/
+			NodeBase * locate( int index ) const;
+
+			/* <! Drops the cached position; called whenever the indices of the nodes may change. */
+			void forget() noexcept { m_finger = nullptr; }
+
+			node_allocator_type m_alloc;
+			mutable Stats m_stats; //<! Updated by const lookups too; empty with no_stats.
 			int m_size;
-			Node *m_head;
-			Node *m_tail;
+			NodeBase m_sentinel; //<! m_sentinel.next is the first node and m_sentinel.prev the last.
+			NodeBase *m_finger = nullptr; //<! Last node reached by the non-const advance_to, or nullptr.
+			int m_finger_index = 0;       //<! Index of m_finger.
 	};
 
 	//=======================================================================================
 
 	//CONST_ITERATOR
 
-	template<typename T>
-	const T& list<T>::const_iterator::operator*(void) const{
-		return current->data;
+	template<typename T, typename Allocator, typename Stats>
+	const T& list<T,Allocator,Stats>::const_iterator::operator*(void) const{
+		return static_cast<Node*>(current)->data;
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator & list<T>::const_iterator::operator++(void){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator & list<T,Allocator,Stats>::const_iterator::operator++(void){
 		this->current = this->current->next;
 		return *this;
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator list<T>::const_iterator::operator++(int){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator list<T,Allocator,Stats>::const_iterator::operator++(int){
 		auto aux = this->current;
 		this->current = this->current->next;
 
 		return aux;
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator & list<T>::const_iterator::operator--(void){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator & list<T,Allocator,Stats>::const_iterator::operator--(void){
 		this->current = this->current->prev;
 		return *this;
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator list<T>::const_iterator::operator--(int){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator list<T,Allocator,Stats>::const_iterator::operator--(int){
 		auto aux = this->current;
 		this->current = this->current->prev;
 
 		return aux;
 	}
 
-	template<typename T>
-	bool list<T>::const_iterator::operator==( const list<T>::const_iterator &rhs) const{
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::const_iterator::operator==( const list<T,Allocator,Stats>::const_iterator &rhs) const{
 		return this->current == rhs.current;
 	}
 
-	template<typename T>
-	bool list<T>::const_iterator::operator!=( const list<T>::const_iterator &rhs) const{
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::const_iterator::operator!=( const list<T,Allocator,Stats>::const_iterator &rhs) const{
 		return this->current != rhs.current;
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator & list<T>::const_iterator::operator+(int add){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator & list<T,Allocator,Stats>::const_iterator::operator+(int add){
 		for( int i = 0; i < add; ++i ){
 			if( this->current == nullptr ){ /*empty*/ }
 			this->current = this->current->next;
 		}
+		Stats::iterator_stepped( add > 0 ? add : 0 );
 		return *this;
 	}
 	
-	template<typename T>
-	typename list<T>::const_iterator* list<T>::const_iterator::operator=(const list<T>::const_iterator &rhs){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator & list<T,Allocator,Stats>::const_iterator::operator=(const list<T,Allocator,Stats>::const_iterator &rhs){
 		this->current = rhs.current;
+		return *this;
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator & list<T>::const_iterator::operator-(int sub){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator & list<T,Allocator,Stats>::const_iterator::operator-(int sub){
 		for( int i = 0; i < sub; ++i ){
 			if( this->current == nullptr ){	/*empty*/ }
 			this->current = this->current->prev;
 		}
+		Stats::iterator_stepped( sub > 0 ? sub : 0 );
 		return *this;
 	}
 
 	//=======================================================================================
 
 	//ITERATOR
-	template<typename T>
-	const T &list<T>::iterator::operator*() const{
-		return this->current->data;
+	template<typename T, typename Allocator, typename Stats>
+	const T &list<T,Allocator,Stats>::iterator::operator*() const{
+		return static_cast<Node*>(this->current)->data;
 	}
 
-	template<typename T>
-	T &list<T>::iterator::operator*(){
-		return this->current->data;
+	template<typename T, typename Allocator, typename Stats>
+	T &list<T,Allocator,Stats>::iterator::operator*(){
+		return static_cast<Node*>(this->current)->data;
 	}
 
-	template<typename T>
-	typename list<T>::iterator & list<T>::iterator::operator+(int add){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator & list<T,Allocator,Stats>::iterator::operator+(int add){
 		for( int i = 0; i < add; ++i ){
 			if( this->current == nullptr ){ /*empty*/ }
 			this->current = this->current->next;
 		}
+		Stats::iterator_stepped( add > 0 ? add : 0 );
 		return *this;
 	}
 
-	template<typename T>
-	typename list<T>::iterator & list<T>::iterator::operator-(int sub){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator & list<T,Allocator,Stats>::iterator::operator-(int sub){
 		for( int i = 0; i < sub; ++i ){
 			if( this->current == nullptr ){	/*empty*/ }
 			this->current = this->current->prev;
 		}
+		Stats::iterator_stepped( sub > 0 ? sub : 0 );
 		return *this;
 	}
 
-	template<typename T>
-	typename list<T>::iterator& list<T>::iterator::operator=(const list<T>::iterator &rhs){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator& list<T,Allocator,Stats>::iterator::operator=(const list<T,Allocator,Stats>::iterator &rhs){
 		this->current = rhs.current;
 		return *this;
 	} 
 
-	template<typename T>
-	typename list<T>::iterator &list<T>::iterator::operator++(){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator &list<T,Allocator,Stats>::iterator::operator++(){
 		this->current = this->current->next;
 		return *this;
 	}
 
-	template<typename T>
-	typename list<T>::iterator list<T>::iterator::operator++(int){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::iterator::operator++(int){
 		auto temp = this->current;
 		this->current = this->current->next;
 
 		return temp;
 	}
 
-	template<typename T>
-	typename list<T>::iterator &list<T>::iterator::operator--(){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator &list<T,Allocator,Stats>::iterator::operator--(){
 		this->current = this->current->prev;
 		return *this;
 	}
 
-	template<typename T>
-	typename list<T>::iterator list<T>::iterator::operator--(int){
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::iterator::operator--(int){
 		auto temp = this->current;
 		this->current = this->current->prev;
 
 		return temp;
 	}
 
-	template<typename T>
-	bool list<T>::iterator::operator==(const list<T>::iterator &rhs) const{
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::iterator::operator==(const list<T,Allocator,Stats>::iterator &rhs) const{
 		return this->current == rhs.current;
 	}
 
-	template<typename T>
-	bool list<T>::iterator::operator!=( const list<T>::iterator &rhs) const{
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::iterator::operator!=( const list<T,Allocator,Stats>::iterator &rhs) const{
 		return this->current != rhs.current;
 	}
 
 	//=======================================================================================
 
-	//SPECIAL MEMBERS 
-	template<typename T>
-	list<T>::list(){
-		
-		m_size = 0;
-		m_head = new Node();
-		m_tail = new Node();
-		m_head->next = m_tail;
-		m_tail->prev = m_head;
+	//NODE ALLOCATION
+	template<typename T, typename Allocator, typename Stats>
+	template<typename... Args>
+	typename list<T,Allocator,Stats>::Node * list<T,Allocator,Stats>::create_node( NodeBase * p, NodeBase * n, Args &&... args ){
+		Node *temp = node_traits::allocate(m_alloc, 1);
+
+		try{
+			node_traits::construct(m_alloc, std::addressof(temp->data), std::forward<Args>(args)...);
+		}catch(...){
+			node_traits::deallocate(m_alloc, temp, 1);
+			throw;
+		}
+
+		m_stats.allocated();
+		temp->prev = p;
+		temp->next = n;
+		return temp;
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::destroy_node( NodeBase * n ){
+		Node *temp = static_cast<Node*>(n);
+		node_traits::destroy(m_alloc, std::addressof(temp->data));
+		node_traits::deallocate(m_alloc, temp, 1);
+		m_stats.freed();
 	}
 
-	template<typename T>
-	list<T>::list( size_type count ){
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::init() noexcept{
 		m_size = 0;
-		m_head = new Node();
-		m_tail = new Node();
-		m_head->next = m_tail;
-		m_tail->prev = m_head;
+		forget();
+		m_sentinel.next = &m_sentinel;
+		m_sentinel.prev = &m_sentinel;
+	}
 
-		for(auto i(0); i < count; i++){
-			push_back(i);
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::release(){
+		destroy_chain(m_sentinel.next, &m_sentinel);
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	template<typename InItr>
+	typename list<T,Allocator,Stats>::Node * list<T,Allocator,Stats>::create_chain( InItr first, InItr last, NodeBase *& tail, int & count ){
+		Node *head = nullptr;
+		NodeBase *back = nullptr;
+		count = 0;
+
+		try{
+			for(; first != last; ++first){
+				Node *temp = create_node(back, nullptr, *first);
+				if(back == nullptr){
+					head = temp;
+				}else{
+					back->next = temp;
+				}
+				back = temp;
+				count++;
+			}
+		}catch(...){
+			destroy_chain(head, nullptr);
+			throw;
 		}
+
+		tail = back;
+		return head;
 	}
 
-	template<typename T>
-	template<typename InputIt>
-	list<T>::list(InputIt first, InputIt last){
-		m_size = 0;
-		m_head = new Node();
-		m_tail = new Node();
-		m_head->next = m_tail;
-		m_tail->prev = m_head;
+	template<typename T, typename Allocator, typename Stats>
+	int list<T,Allocator,Stats>::destroy_chain( NodeBase * first, NodeBase * last ){
+		int count = 0;
 
-		for(auto i(first); i != last; i++){
-			push_back(*i);
+		while(first != last){
+			NodeBase *temp = first;
+			first = first->next;
+			destroy_node(temp);
+			count++;
 		}
+
+		return count;
 	}
 
-	template<typename T>
-	list<T>::list(const list &other){
-		m_size = 0;
-		m_head = new Node();
-		m_tail = new Node();
-		m_head->next = m_tail;
-		m_tail->prev = m_head;
-		
-		for(auto i(other.cbegin()); i != other.cend(); i++){
-			push_back(*i);
-		}	
-	}
-
-	template<typename T>
-	list<T>::list(std::initializer_list<T> ilist){
-		m_size = 0;
-		m_head = new Node();
-		m_tail = new Node();
-		m_head->next = m_tail;
-		m_tail->prev = m_head;
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::steal( list & other ) noexcept{
+		if(other.m_size == 0) return;
+
+		m_sentinel.next = other.m_sentinel.next;
+		m_sentinel.prev = other.m_sentinel.prev;
+		m_sentinel.next->prev = &m_sentinel;
+		m_sentinel.prev->next = &m_sentinel;
+		m_size = other.m_size;
+
+		other.init();
+	}
+
+	//=======================================================================================
+
+	//SPECIAL MEMBERS 
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::list() : list( Allocator() ){ /*empty*/ }
+
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::list( const Allocator & alloc ) : m_alloc(alloc){
+		init();
+	}
 
-		for(auto &i : ilist){
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::list( size_type count, const Allocator & alloc ) : m_alloc(alloc){
+		init();
+
+		for(auto i(0); i < count; i++){
 			push_back(i);
 		}
 	}
 
-	template<typename T>
-	list<T>::~list(){
-		Node *temp = m_head;
+	template<typename T, typename Allocator, typename Stats>
+	template<typename InputIt>
+	list<T,Allocator,Stats>::list(InputIt first, InputIt last, const Allocator & alloc) : m_alloc(alloc){
+		init();
+		insert(cend(), first, last);
+	}
 
-		while (temp != m_tail){
-			temp = temp->next;
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::list(const list &other) :
+		list( other, node_traits::select_on_container_copy_construction(other.m_alloc) ){ /*empty*/ }
 
-			if(temp->prev != m_head){
-				delete temp->prev;
-			}
-		}
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::list(const list &other, const Allocator & alloc) : m_alloc(alloc){
+		init();
+		insert(cend(), other.cbegin(), other.cend());
+	}
 
-		delete m_head;
-		delete m_tail;
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::list(list &&other) noexcept : m_alloc(other.m_alloc){
+		init();
+		steal(other);
 	}
 
-	template<typename T>
-	list<T> &list<T>::operator=( const list &other ){
-		if(m_size != 0){
-			clear();
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::list(std::initializer_list<T> ilist, const Allocator & alloc) : m_alloc(alloc){
+		init();
+		insert(cend(), ilist.begin(), ilist.end());
+	}
 
-			m_size = 0;
-			m_head = new Node();
-			m_tail = new Node();
-			m_head->next = m_tail;
-			m_tail->prev = m_head;	
-		}
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats>::~list(){
+		release();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats> &list<T,Allocator,Stats>::operator=( const list &other ){
+		if(this == &other) return *this;
 
-		for(auto i(other.cbegin()); i != other.cend(); i++){
-			push_back(*i);
+		if constexpr(node_traits::propagate_on_container_copy_assignment::value){
+			// Nodes of the old allocator cannot be kept under the new one.
+			if(m_alloc != other.m_alloc) clear();
+			m_alloc = other.m_alloc;
 		}
 
+		assign(other.cbegin(), other.cend());
+
 		return *this;
 	}
 
-	template<typename T>
-	list<T> & list<T>::operator= (std::initializer_list<T> ilist){
-		if(m_size != 0){
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats> &list<T,Allocator,Stats>::operator=( list &&other ){
+		if(this == &other) return *this;
+
+		if(node_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc){
 			clear();
 
-			m_size = 0;
-			m_head = new Node();
-			m_tail = new Node();
-			m_head->next = m_tail;
-			m_tail->prev = m_head;	
-		}
+			if constexpr(node_traits::propagate_on_container_move_assignment::value){
+				m_alloc = other.m_alloc;
+			}
 
-		for(auto &i : ilist){
-			push_back(i);
+			steal(other);
+		}else{
+			// Nodes cannot change hands between unrelated allocators.
+			clear();
+			for(auto i(other.begin()); i != other.end(); i++){
+				push_back(std::move(*i));
+			}
+			other.clear();
 		}
 
 		return *this;
 	}
 
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats> & list<T,Allocator,Stats>::operator= (std::initializer_list<T> ilist){
+		assign(ilist.begin(), ilist.end());
+
+		return *this;
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::allocator_type list<T,Allocator,Stats>::get_allocator() const{
+		return allocator_type(m_alloc);
+	}
+
 	//=======================================================================================
 
 	//ITERATORS
-	template<typename T>
-	typename ls::list<T>::iterator ls::list<T>::begin(void){
-		return list<T>::iterator(this->m_head->next);
+	template<typename T, typename Allocator, typename Stats>
+	typename ls::list<T,Allocator,Stats>::iterator ls::list<T,Allocator,Stats>::begin(void){
+		return list<T,Allocator,Stats>::iterator(this->m_sentinel.next);
 	}
 
-	template<typename T>
-	typename ls::list<T>::const_iterator ls::list<T>::cbegin(void) const{
-		return list<T>::const_iterator(this->m_head->next);
+	template<typename T, typename Allocator, typename Stats>
+	typename ls::list<T,Allocator,Stats>::const_iterator ls::list<T,Allocator,Stats>::cbegin(void) const{
+		return list<T,Allocator,Stats>::const_iterator(this->m_sentinel.next);
 	}
 
-	template<typename T>
-	typename ls::list<T>::iterator ls::list<T>::end(void){
-		return list<T>::iterator(this->m_tail);
+	template<typename T, typename Allocator, typename Stats>
+	typename ls::list<T,Allocator,Stats>::iterator ls::list<T,Allocator,Stats>::end(void){
+		return list<T,Allocator,Stats>::iterator(&this->m_sentinel);
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator ls::list<T>::cend(void) const{
-		return list<T>::const_iterator(this->m_tail);
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator ls::list<T,Allocator,Stats>::cend(void) const{
+		return list<T,Allocator,Stats>::const_iterator(const_cast<NodeBase*>(&this->m_sentinel));
 	}
 
 	//=======================================================================================
 
 	//CAPACITY
-	template<typename T>
-	int list<T>::size() const{
+	template<typename T, typename Allocator, typename Stats>
+	int list<T,Allocator,Stats>::size() const{
 		return m_size;
 	}
 
-	template<typename T>
-	bool list<T>::empty() const{
-		return (m_head->next == m_tail) && (m_tail->prev == m_head);
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::empty() const{
+		return m_sentinel.next == &m_sentinel;
 	}
 
 	//=======================================================================================
 
 	//MODIFIERS
-	template<typename T>
-	void list<T>::clear(void){
-		erase(begin(),end());
-
-		m_size = 0;
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::clear(void){
+		release();
+		init();
 	}
 
-	template<typename T>
-	const T & list<T>::front(void) const{
-		return m_head->next->data;
+	template<typename T, typename Allocator, typename Stats>
+	const T & list<T,Allocator,Stats>::front(void) const{
+		return static_cast<Node*>(m_sentinel.next)->data;
 	}
 
-	template<typename T>
-	T & list<T>::back(void){
-		return m_tail->prev->data;
+	template<typename T, typename Allocator, typename Stats>
+	T & list<T,Allocator,Stats>::back(void){
+		return static_cast<Node*>(m_sentinel.prev)->data;
 	}
 
-	template<typename T>
-	const T & list<T>::back(void) const{
-		return m_tail->prev->data;
+	template<typename T, typename Allocator, typename Stats>
+	const T & list<T,Allocator,Stats>::back(void) const{
+		return static_cast<Node*>(m_sentinel.prev)->data;
 	} 
 
-	template<typename T>
-	void list<T>::push_front( const T & value ){
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::push_front( const T & value ){
+		emplace_front(value);
+	}
 
-		Node *temp = new Node(value, m_head,m_head->next);
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::push_front( T && value ){
+		emplace_front(std::move(value));
+	}
 
-		m_head->next->prev = temp;
-		m_head->next = temp;
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::push_back( const T & value ){
+		emplace_back(value);
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::push_back( T && value ){
+		emplace_back(std::move(value));
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	template<typename... Args>
+	T & list<T,Allocator,Stats>::emplace_front( Args &&... args ){
+
+		Node *temp = create_node(&m_sentinel, m_sentinel.next, std::forward<Args>(args)...);
+
+		m_sentinel.next->prev = temp;
+		m_sentinel.next = temp;
 		m_size ++;
+		forget();
+
+		return temp->data;
 	}
 
-	template<typename T>
-	void list<T>::push_back( const T & value ){
-		Node *temp = new Node(value,m_tail->prev, m_tail);
-		m_tail->prev->next = temp;
-		m_tail->prev = temp;
+	template<typename T, typename Allocator, typename Stats>
+	template<typename... Args>
+	T & list<T,Allocator,Stats>::emplace_back( Args &&... args ){
+		Node *temp = create_node(m_sentinel.prev, &m_sentinel, std::forward<Args>(args)...);
+		m_sentinel.prev->next = temp;
+		m_sentinel.prev = temp;
 
 		m_size ++;
+
+		return temp->data;
 	}
 
-	template<typename T>
-	void list<T>::pop_back(void){
-		erase(m_tail->prev);
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::pop_back(void){
+		erase(m_sentinel.prev);
 	}
 
-	template<typename T>
-	void list<T>::pop_front(void){
-		erase(this->m_head->next);
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::pop_front(void){
+		erase(this->m_sentinel.next);
 	}
 
-	template<typename T>
-	void list<T>::assign( const T & value ){
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::assign( const T & value ){
 		for(auto i(begin()); i != end(); i++){
 			*i = value;
 		}
@@ -701,140 +1091,539 @@ template<typename T>
 	//=======================================================================================
 
 	//MODIFIERS WITH ITERATORS
-	template<typename T>
+	template<typename T, typename Allocator, typename Stats>
 	template<typename InItr>
-	void list<T>::assign(InItr first, InItr last){
-		if(m_size != 0){
-			clear();
+	void list<T,Allocator,Stats>::assign(InItr first, InItr last){
+		iterator i(begin());
+		for(; i != end() && first != last; ++i, ++first){
+			*i = *first;
 		}
 
-		insert(begin(), first, last);
+		if(first == last){
+			erase(i, end());
+		}else{
+			insert(end(), first, last);
+		}
 	}
 
-	template<typename T>
-	void list<T>::assign( std::initializer_list<T> ilist ){
-		if(m_size != 0){
-			clear();
-		}
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::assign( std::initializer_list<T> ilist ){
+		assign(ilist.begin(), ilist.end());
+	}
 
-		insert(begin(), ilist.begin(), ilist.end());
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::insert( list<T,Allocator,Stats>::const_iterator itr, const T & value ){
+		return emplace(itr, value);
 	}
 
-	template<typename T>
-	typename list<T>::iterator list<T>::insert( list<T>::const_iterator itr, const T & value ){
-		Node *temp = new Node(value, itr.current->prev,itr.current );
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::insert( list<T,Allocator,Stats>::const_iterator itr, T && value ){
+		return emplace(itr, std::move(value));
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	template<typename... Args>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::emplace( list<T,Allocator,Stats>::const_iterator itr, Args &&... args ){
+		Node *temp = create_node(itr.current->prev, itr.current, std::forward<Args>(args)...);
 
 		m_size ++;
 		itr.current->prev->next = temp;
 		itr.current->prev = temp;
+		forget();
 
 		return temp;
 	}
 
-	template<typename T>
+	template<typename T, typename Allocator, typename Stats>
 	template<typename InItr>
-	typename list<T>::iterator list<T>::insert( list<T>::iterator pos, InItr first, InItr last ){
-		list<T>::iterator temp(pos);
-		int size (0);
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::insert( list<T,Allocator,Stats>::const_iterator pos, InItr first, InItr last ){
+		NodeBase *tail;
+		int size;
+		Node *head = create_chain(first, last, tail, size);
 
-		for(auto i(first); i != last; ++i){
-			temp = list<T>::insert(pos,*i);
-			size++;
+		if(head == nullptr){
+			return list<T,Allocator,Stats>::iterator(pos.current);
 		}
 
-		if(temp == begin()){
-			return temp;
+		NodeBase *before = pos.current->prev;
+		before->next = head;
+		head->prev = before;
+		tail->next = pos.current;
+		pos.current->prev = tail;
+		m_size += size;
+		forget();
+
+		return list<T,Allocator,Stats>::iterator(head);
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::insert( list<T,Allocator,Stats>::const_iterator pos, std::initializer_list<T> ilist ){
+		return insert(pos, ilist.begin(), ilist.end());
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::erase( list<T,Allocator,Stats>::const_iterator itr ){
+		auto temp = list<T,Allocator,Stats>::iterator(itr.current->next);
+		if(itr != end()){
+			itr.current->next->prev = itr.current->prev;
+			itr.current->prev->next = itr.current->next;
+			destroy_node(itr.current);
+			m_size --;
+			forget();
 		}else{
-			return temp - size + 1;
+			m_stats.erased_end();
 		}
+
+		return temp;
 	}
 
-	template<typename T>
-	typename list<T>::iterator list<T>::insert( list<T>::const_iterator pos, std::initializer_list<T> ilist ){
-		list<T>::iterator temp;
-		int size = ilist.size();
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::erase( list<T,Allocator,Stats>::const_iterator first, list<T,Allocator,Stats>::const_iterator last ){
+		if( first != last ){
+			NodeBase *before = first.current->prev;
+			before->next = last.current;
+			last.current->prev = before;
 
-		for(auto i(ilist.begin()); i != ilist.end(); i++){
-			temp = insert(pos,*i);
+			m_size -= destroy_chain(first.current, last.current);
+			forget();
 		}
 
-		if(temp == begin()){
-			return temp;
-		}else{
-			return temp - size + 1;
+		return list<T,Allocator,Stats>::iterator(last.current);
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator list<T,Allocator,Stats>::find( const T & value ) const{
+		NodeBase *temp = m_sentinel.next;
+		std::size_t probes = 0;
+
+		while (temp != &m_sentinel){
+			probes++;
+
+			if(static_cast<Node*>(temp)->data == value){
+				m_stats.searched(probes, true);
+				return list<T,Allocator,Stats>::const_iterator(temp);
+			}
+
+			temp = temp->next;
 		}
+
+		m_stats.searched(probes, false);
+		return cend();
 	}
 
-	template<typename T>
-	typename list<T>::iterator list<T>::erase( list<T>::const_iterator itr ){
-		auto temp = list<T>::iterator(itr.current->next);
-		if(itr != end()){
-			itr.current->next->prev = itr.current->prev;
-			itr.current->prev->next = itr.current->next;
-			delete itr.current;
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::next(list<T,Allocator,Stats>::iterator first, const T& value){
+		if(value >= 0){
+			if(m_finger != nullptr && first.current == m_finger){
+				return advance_to(m_finger_index + value);
+			}
+			if(first.current == m_sentinel.next){
+				return advance_to(value);
+			}
 		}
 
-		m_size --;
+		return list<T,Allocator,Stats>::iterator(first + value);
+	}
 
-		return temp;
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::advance_to( int index ){
+		NodeBase *temp = locate(index);
+		if(temp != &m_sentinel){
+			m_finger = temp;
+			m_finger_index = index;
+		}
+		return list<T,Allocator,Stats>::iterator(temp);
 	}
 
-	template<typename T>
-	typename list<T>::iterator list<T>::erase( list<T>::iterator first, list<T>::iterator last ){
-		list<T>::iterator temp = erase(first);
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::const_iterator list<T,Allocator,Stats>::advance_to( int index ) const{
+		return list<T,Allocator,Stats>::const_iterator(locate(index));
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::NodeBase * list<T,Allocator,Stats>::locate( int index ) const{
+		if(index >= m_size) return const_cast<NodeBase*>(&m_sentinel);
+
+		NodeBase *temp;
+		int at;
+		if(index <= m_size - 1 - index){
+			temp = m_sentinel.next;
+			at = 0;
+		}else{
+			temp = m_sentinel.prev;
+			at = m_size - 1;
+		}
 
-		while( temp != last ){
-			temp = erase(temp);
+		if(m_finger != nullptr){
+			int from_finger = (index > m_finger_index) ? index - m_finger_index : m_finger_index - index;
+			int from_end = (index > at) ? index - at : at - index;
+			if(from_finger < from_end){
+				temp = m_finger;
+				at = m_finger_index;
+			}
 		}
 
+		m_stats.stepped( (index > at) ? index - at : at - index );
+		for(; at < index; ++at) temp = temp->next;
+		for(; at > index; --at) temp = temp->prev;
+
 		return temp;
 	}
 
-	template<typename T>
-	typename list<T>::const_iterator list<T>::find( const T & value ) const{
-		Node *temp = m_head;
+	//=======================================================================================
+
+	//OPERATIONS
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::transfer( NodeBase * pos, NodeBase * first, NodeBase * last ) noexcept{
+		if(first == last) return;
+
+		NodeBase *last_in = last->prev;
+
+		first->prev->next = last;
+		last->prev = first->prev;
+
+		NodeBase *before = pos->prev;
+		before->next = first;
+		first->prev = before;
+		last_in->next = pos;
+		pos->prev = last_in;
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::splice( list<T,Allocator,Stats>::const_iterator pos, list &other ){
+		if(this == &other || other.m_size == 0) return;
 
-		while (temp != m_tail){
+		transfer(pos.current, other.m_sentinel.next, &other.m_sentinel);
+		m_size += other.m_size;
+		other.init();
+		forget();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::splice( list<T,Allocator,Stats>::const_iterator pos, list &&other ){
+		splice(pos, other);
+	}
 
-			if(temp->data == value){
-				return list<T>::const_iterator(temp);
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::splice( list<T,Allocator,Stats>::const_iterator pos, list &other, list<T,Allocator,Stats>::const_iterator it ){
+		if(pos.current == it.current || pos.current == it.current->next) return;
+
+		transfer(pos.current, it.current, it.current->next);
+		m_size++;
+		other.m_size--;
+		forget();
+		other.forget();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::splice( list<T,Allocator,Stats>::const_iterator pos, list &other, list<T,Allocator,Stats>::const_iterator first, list<T,Allocator,Stats>::const_iterator last ){
+		if(first == last) return;
+
+		if(this != &other){
+			int count = 0;
+			for(NodeBase *temp = first.current; temp != last.current; temp = temp->next){
+				count++;
 			}
+			m_size += count;
+			other.m_size -= count;
+		}
 
-			temp = temp->next;
+		transfer(pos.current, first.current, last.current);
+		forget();
+		other.forget();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	list<T,Allocator,Stats> list<T,Allocator,Stats>::split_at( list<T,Allocator,Stats>::const_iterator pos ){
+		list<T,Allocator,Stats> tail( get_allocator() );
+
+		// Walk from pos towards both ends at once and stop at whichever comes first.
+		NodeBase *forward = pos.current;
+		NodeBase *backward = pos.current;
+		int count = 0;
+		while(forward != &m_sentinel && backward != m_sentinel.next){
+			forward = forward->next;
+			backward = backward->prev;
+			count++;
+		}
+		int tail_size = (forward == &m_sentinel) ? count : m_size - count;
+
+		transfer(&tail.m_sentinel, pos.current, &m_sentinel);
+		tail.m_size = tail_size;
+		m_size -= tail_size;
+		forget();
+
+		return tail;
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	template<typename Compare>
+	typename list<T,Allocator,Stats>::NodeBase * list<T,Allocator,Stats>::merge_chains( NodeBase * a, NodeBase * b, Compare & comp ){
+		NodeBase head;
+		NodeBase *tail = &head;
+
+		while(a != nullptr && b != nullptr){
+			// Ties go to a, which keeps the merge stable.
+			if(comp(static_cast<Node*>(b)->data, static_cast<Node*>(a)->data)){
+				tail->next = b;
+				b = b->next;
+			}else{
+				tail->next = a;
+				a = a->next;
+			}
+			tail = tail->next;
 		}
+		tail->next = (a != nullptr) ? a : b;
 
-		return list<T>::const_iterator(temp);
+		return head.next;
 	}
 
-	template<typename T>
-	typename list<T>::iterator list<T>::next(list<T>::iterator first, const T& value){
-		return list<T>::iterator(first + value);
+	template<typename T, typename Allocator, typename Stats>
+	template<typename Compare>
+	typename list<T,Allocator,Stats>::NodeBase * list<T,Allocator,Stats>::sort_chain( NodeBase * first, Compare & comp ){
+		// bins[i] holds a sorted run of 2^i nodes, older runs in higher bins.
+		NodeBase *bins[64] = {};
+		int used = 0;
+
+		while(first != nullptr){
+			NodeBase *carry = first;
+			first = first->next;
+			carry->next = nullptr;
+
+			int i = 0;
+			for(; bins[i] != nullptr; ++i){
+				carry = merge_chains(bins[i], carry, comp);
+				bins[i] = nullptr;
+			}
+			bins[i] = carry;
+			if(i >= used) used = i + 1;
+		}
+
+		NodeBase *result = nullptr;
+		for(int i = 0; i < used; ++i){
+			if(bins[i] != nullptr){
+				result = merge_chains(bins[i], result, comp);
+			}
+		}
+
+		return result;
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::relink( NodeBase * first ) noexcept{
+		NodeBase *prev = &m_sentinel;
+
+		for(NodeBase *temp = first; temp != nullptr; temp = temp->next){
+			prev->next = temp;
+			temp->prev = prev;
+			prev = temp;
+		}
+
+		prev->next = &m_sentinel;
+		m_sentinel.prev = prev;
 	}
 
-	template<typename T>
-	bool list<T>::operator==(const list &rhs){
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::merge( list &other ){
+		merge(other, std::less<T>());
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	template<typename Compare>
+	void list<T,Allocator,Stats>::merge( list &other, Compare comp ){
+		if(this == &other || other.m_size == 0) return;
+
+		m_sentinel.prev->next = nullptr;
+		other.m_sentinel.prev->next = nullptr;
+		NodeBase *a = (m_size == 0) ? nullptr : m_sentinel.next;
+
+		relink(merge_chains(a, other.m_sentinel.next, comp));
+		m_size += other.m_size;
+		other.init();
+		forget();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::sort(){
+		sort(std::less<T>());
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	template<typename Compare>
+	void list<T,Allocator,Stats>::sort( Compare comp ){
+		if(m_size < 2) return;
+
+		m_sentinel.prev->next = nullptr;
+		relink(sort_chain(m_sentinel.next, comp));
+		forget();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void list<T,Allocator,Stats>::reverse() noexcept{
+		NodeBase *temp = &m_sentinel;
+
+		do{
+			std::swap(temp->prev, temp->next);
+			temp = temp->prev;
+		}while(temp != &m_sentinel);
+		forget();
+	}
+
+	//=======================================================================================
+
+	//LOCALITY
+	template<typename T, typename Allocator, typename Stats>
+	typename list<T,Allocator,Stats>::iterator list<T,Allocator,Stats>::compact( const_iterator first, int count ){
+		std::vector<NodeBase*> old;
+		old.reserve( std::max( 0, std::min(count, m_size) ) );
+		for(NodeBase *temp = first.current; temp != &m_sentinel && int(old.size()) < count; temp = temp->next){
+			old.push_back(temp);
+		}
+		if(old.empty()) return iterator(first.current);
+
+		std::vector<Node*> fresh;
+		if constexpr( std::is_same<node_allocator_type, pool_allocator<Node> >::value ){
+			// One run of adjacent slots: recycled slots would be scattered over the old blocks.
+			fresh.resize(old.size());
+			m_alloc.allocate_run(fresh.data(), fresh.size());
+		}else{
+			// The old nodes are still held, so every fresh one is a different slot.
+			fresh.reserve(old.size());
+			try{
+				while(fresh.size() < old.size()){
+					fresh.push_back( node_traits::allocate(m_alloc, 1) );
+				}
+			}catch(...){
+				for(Node *n : fresh) node_traits::deallocate(m_alloc, n, 1);
+				throw;
+			}
+			std::sort( fresh.begin(), fresh.end(), std::less<Node*>() );
+		}
+		m_stats.allocated(fresh.size());
+
+		std::size_t built = 0;
+		try{
+			for(; built < old.size(); ++built){
+				node_traits::construct( m_alloc, std::addressof(fresh[built]->data), std::move_if_noexcept( static_cast<Node*>(old[built])->data ) );
+			}
+		}catch(...){
+			for(std::size_t i = 0; i < built; ++i) node_traits::destroy(m_alloc, std::addressof(fresh[i]->data));
+			for(Node *n : fresh) node_traits::deallocate(m_alloc, n, 1);
+			m_stats.freed(fresh.size());
+			throw;
+		}
+
+		// Every fresh node takes the place of its old node.
+		NodeBase *before = old.front()->prev;
+		NodeBase *after = old.back()->next;
+		NodeBase *prev = before;
+		for(Node *n : fresh){
+			prev->next = n;
+			n->prev = prev;
+			prev = n;
+		}
+		prev->next = after;
+		after->prev = prev;
+
+		for(NodeBase *n : old){
+			destroy_node(n);
+		}
+		forget();
+
+		return iterator(after);
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	double list<T,Allocator,Stats>::fragmentation() const noexcept{
+		if(m_size < 2) return 0.0;
+
+		long double total = 0;
+		for(const NodeBase *temp = m_sentinel.next; temp->next != &m_sentinel; temp = temp->next){
+			std::uintptr_t a = reinterpret_cast<std::uintptr_t>(temp);
+			std::uintptr_t b = reinterpret_cast<std::uintptr_t>(temp->next);
+			total += (a < b) ? b - a : a - b;
+		}
+
+		return double( total / (m_size - 1) / sizeof(Node) );
+	}
+
+	//=======================================================================================
+
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::operator==(const list &rhs) const{
 		if( this->m_size != rhs.m_size ) return false;
-		for( int i = 0; i < m_size; i++ ){
-			if( *(cbegin() + i) != *(rhs.cbegin() + i) ) return false;
+
+		auto j(rhs.cbegin());
+		for( auto i(cbegin()); i != cend(); ++i, ++j ){
+			if( !(*i == *j) ) return false;
 		}
 		return true;
 	}
 
-	template <typename T>
-	bool list<T>::operator!=( const list &rhs ){
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::operator!=( const list &rhs ) const{
 	/* Function implementation {{{*/
 		if ((*this) == rhs) return false;
 		return true;
 	}
 
-	template<typename T>
-	std::ostream& operator<<(std::ostream &os_, list<T> &v){
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::operator<( const list &rhs ) const{
+		auto j(rhs.cbegin());
+		for( auto i(cbegin()); i != cend(); ++i, ++j ){
+			if( j == rhs.cend() || *j < *i ) return false;
+			if( *i < *j ) return true;
+		}
+		return j != rhs.cend();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::operator>( const list &rhs ) const{
+		return rhs < *this;
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::operator<=( const list &rhs ) const{
+		return !(rhs < *this);
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	bool list<T,Allocator,Stats>::operator>=( const list &rhs ) const{
+		return !(*this < rhs);
+	}
+
+#if __cpp_impl_three_way_comparison >= 201907L && __cpp_lib_three_way_comparison >= 201907L
+	template<typename T, typename Allocator, typename Stats>
+	template<typename U>
+	std::compare_three_way_result_t<U> list<T,Allocator,Stats>::operator<=>( const list &rhs ) const{
+		auto j(rhs.cbegin());
+		for( auto i(cbegin()); i != cend(); ++i, ++j ){
+			if( j == rhs.cend() ) return std::strong_ordering::greater;
+			auto order = *i <=> *j;
+			if( order != 0 ) return order;
+		}
+		return (j == rhs.cend()) ? std::strong_ordering::equal : std::strong_ordering::less;
+	}
+#endif
+
+	/* <! Writes every element followed by a space, through the stream's own formatting.
+		Only the public interface is used, so it needs no friendship. For large dumps of numbers,
+		ls::write_text in list_io.h is much faster.
+	*/
+	template<typename T, typename Allocator, typename Stats>
+	std::ostream& operator<<(std::ostream &os_, const list<T,Allocator,Stats> &v){
 		for(auto i(v.cbegin());i != v.cend(); i++){
 			os_ << *i << ' ';
 		}
 
 		return os_;
 	}
+
+	namespace pmr{
+		/* <! A list whose nodes come from a std::pmr::memory_resource. */
+		template<typename T>
+		using list = ls::list<T, std::pmr::polymorphic_allocator<T> >;
+	}
 }
 
 #endif
@@ -0,0 +1,391 @@
+#ifndef LIST_IO_H
+#define LIST_IO_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "list.h"
+
+namespace ls{
+	/* <! Buffered byte sink over an ostream: writes reach the stream in blocks of capacity bytes. */
+	class binary_writer
+	{
+		public:
+			static constexpr std::size_t capacity = 1 << 16;
+
+			explicit binary_writer( std::ostream & os ) : m_os(os){ m_buffer.reserve(capacity); }
+			binary_writer( const binary_writer & ) = delete;
+			binary_writer & operator= ( const binary_writer & ) = delete;
+
+			/* <! Appends count bytes from data. */
+			void write( const void * data, std::size_t count );
+
+			/* <! Hands the buffered bytes to the stream. Throws std::runtime_error if the stream fails. */
+			void flush();
+
+		private:
+			std::ostream & m_os;
+			std::vector<char> m_buffer;
+	};
+
+	/* <! Byte source over an istream. It never reads ahead, so whatever follows a list in the stream
+		is left for the next reader; callers read large blocks where they can.
+	*/
+	class binary_reader
+	{
+		public:
+			/* <! Largest block read at once by deserialize. */
+			static constexpr std::size_t capacity = 1 << 16;
+
+			explicit binary_reader( std::istream & is ) : m_is(is){ /*empty*/ }
+			binary_reader( const binary_reader & ) = delete;
+			binary_reader & operator= ( const binary_reader & ) = delete;
+
+			/* <! Reads exactly count bytes into data. Throws std::runtime_error at the end of the stream. */
+			void read( void * data, std::size_t count );
+
+		private:
+			std::istream & m_is;
+	};
+
+	/* <! How one element is written and read by serialize and deserialize. Trivially copyable types
+		that can be default constructed are copied as their bytes, in blocks; std::basic_string is
+		length-prefixed. Specialize it for other types with the same two members.
+	*/
+	template<typename T, typename = void>
+	struct binary_codec;
+
+	template<typename T>
+	struct binary_codec< T, std::enable_if_t< std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value > >{
+		static void write( binary_writer & out, const T & value ){ out.write(std::addressof(value), sizeof(T)); }
+
+		static T read( binary_reader & in ){
+			// The bytes are copied into a T that exists, which is what trivially copyable allows.
+			T value;
+			in.read(std::addressof(value), sizeof(T));
+			return value;
+		}
+	};
+
+	template<typename Char, typename Traits, typename Alloc>
+	struct binary_codec< std::basic_string<Char,Traits,Alloc>, std::enable_if_t< std::is_trivially_copyable<Char>::value > >{
+		static void write( binary_writer & out, const std::basic_string<Char,Traits,Alloc> & value ){
+			std::uint64_t length = value.size();
+			out.write(&length, sizeof(length));
+			out.write(value.data(), value.size() * sizeof(Char));
+		}
+
+		static std::basic_string<Char,Traits,Alloc> read( binary_reader & in ){
+			std::uint64_t length;
+			in.read(&length, sizeof(length));
+
+			std::basic_string<Char,Traits,Alloc> value;
+			// Grown as the bytes arrive, so a corrupt length cannot allocate more than the stream holds.
+			while(length > 0){
+				std::size_t step = std::size_t( std::min<std::uint64_t>( length, binary_reader::capacity / sizeof(Char) ) );
+				std::size_t old = value.size();
+				value.resize(old + step);
+				in.read(&value[old], step * sizeof(Char));
+				length -= step;
+			}
+			return value;
+		}
+	};
+
+	/* <! Writes seq to os: a header, with the element count, then every element through binary_codec.
+		Trivially copyable elements are gathered into 64 KiB blocks, so the stream sees few large writes.
+		The format uses the byte order and type sizes of the machine. Both are checked on reading, with
+		the kind of element: signed or unsigned integer, floating point, string, or other bytes.
+		Throws std::runtime_error if the stream fails.
+	*/
+	template<typename T, typename Allocator, typename Stats>
+	void serialize( const list<T,Allocator,Stats> & seq, std::ostream & os );
+
+	/* <! Reads a list written by serialize, appending its elements to seq. Elements are built chunk by
+		chunk, so besides the nodes only one 64 KiB block is held at a time. seq is left untouched if the
+		stream is truncated or its elements differ from T in kind or size; that throws std::runtime_error.
+		Two other trivially copyable types of the same size, such as two structs, are not told apart.
+	*/
+	template<typename T, typename Allocator, typename Stats>
+	void deserialize( std::istream & is, list<T,Allocator,Stats> & seq );
+
+	/* <! Reads a list written by serialize. */
+	template<typename T, typename Allocator = pool_allocator<T> >
+	list<T,Allocator> deserialize( std::istream & is ){
+		list<T,Allocator> seq;
+		deserialize(is, seq);
+		return seq;
+	}
+
+	/* <! Writes every element of seq followed by sep, like operator<< does with a space.
+		Integers and floating point numbers are formatted with std::to_chars into a 1 MiB buffer,
+		reused by the calling thread, which reaches the stream in a few large writes; floating point
+		numbers come out in their shortest form that reads back exactly. Other types go through
+		the stream's operator<<. Throws std::runtime_error if the stream fails.
+	*/
+	template<typename T, typename Allocator, typename Stats>
+	void write_text( std::ostream & os, const list<T,Allocator,Stats> & seq, char sep = ' ' );
+
+	/* <! Reads whitespace-separated values until the end of is and appends them to seq.
+		Numbers are parsed with std::from_chars straight from 1 MiB blocks of the stream and built
+		into nodes as they are parsed; other types go through the stream's operator>>.
+		On a malformed or out-of-range value, is gets failbit and seq is left as it was.
+		@return The number of elements appended.
+	*/
+	template<typename T, typename Allocator, typename Stats>
+	int read_text( std::istream & is, list<T,Allocator,Stats> & seq );
+
+	/* <! Same as read_text: reads values until the end of is and appends them to seq. */
+	template<typename T, typename Allocator, typename Stats>
+	std::istream & operator>>( std::istream & is, list<T,Allocator,Stats> & seq ){
+		read_text(is, seq);
+		return is;
+	}
+
+	namespace detail{
+		/* <! Types formatted and parsed with to_chars and from_chars: numbers, but not characters or bool. */
+		template<typename T>
+		constexpr bool fast_text = ( std::is_integral<T>::value || std::is_floating_point<T>::value ) &&
+			!std::is_same<T,bool>::value && !std::is_same<T,char>::value && !std::is_same<T,signed char>::value &&
+			!std::is_same<T,unsigned char>::value && !std::is_same<T,wchar_t>::value &&
+			!std::is_same<T,char16_t>::value && !std::is_same<T,char32_t>::value;
+
+		/* <! Size of the text blocks, and room kept for the longest number. */
+		constexpr std::size_t text_block = 1 << 20;
+		constexpr std::size_t text_room = 128;
+
+		inline bool is_space( char c ){
+			return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+		}
+
+		/* <! Leading bytes of a serialized list. */
+		struct binary_header{
+			char magic[4];             //<! "LSLB".
+			std::uint32_t byte_order;  //<! 0x01020304, as written by the machine.
+			std::uint32_t kind;        //<! element_kind of the elements.
+			std::uint32_t element;     //<! sizeof(T), or sizeof(Char) for strings; 0 for other types.
+			std::uint64_t count;       //<! Number of elements.
+		};
+
+		constexpr char binary_magic[4] = { 'L', 'S', 'L', 'B' };
+		constexpr std::uint32_t binary_byte_order = 0x01020304;
+
+		/* <! What the elements of a serialized list are, beyond their size. */
+		enum element_kind : std::uint32_t { other_kind = 0, signed_kind = 1, unsigned_kind = 2, floating_kind = 3, bytes_kind = 4, string_kind = 5 };
+
+		template<typename T>
+		struct is_basic_string : std::false_type{};
+
+		template<typename Char, typename Traits, typename Alloc>
+		struct is_basic_string< std::basic_string<Char,Traits,Alloc> > : std::true_type{};
+
+		template<typename T>
+		constexpr std::uint32_t element_kind_of(){
+			if constexpr(std::is_floating_point<T>::value) return floating_kind;
+			else if constexpr(std::is_integral<T>::value) return std::is_signed<T>::value ? signed_kind : unsigned_kind;
+			else if constexpr(std::is_trivially_copyable<T>::value) return bytes_kind;
+			else if constexpr(is_basic_string<T>::value) return string_kind;
+			else return other_kind;
+		}
+
+		template<typename T>
+		constexpr std::uint32_t element_size_of(){
+			if constexpr(is_basic_string<T>::value) return std::uint32_t( sizeof(typename T::value_type) );
+			else if constexpr(std::is_trivially_copyable<T>::value) return std::uint32_t( sizeof(T) );
+			else return 0;
+		}
+	}
+
+	//=======================================================================================
+
+	//BINARY_WRITER
+	inline void binary_writer::write( const void * data, std::size_t count ){
+		const char *bytes = static_cast<const char*>(data);
+
+		if(m_buffer.size() + count > capacity){
+			flush();
+			if(count >= capacity){
+				// Large writes skip the buffer.
+				if(!m_os.write(bytes, std::streamsize(count))) throw std::runtime_error("ls::serialize: write failed");
+				return;
+			}
+		}
+		m_buffer.insert(m_buffer.end(), bytes, bytes + count);
+	}
+
+	inline void binary_writer::flush(){
+		if(!m_buffer.empty()){
+			if(!m_os.write(m_buffer.data(), std::streamsize(m_buffer.size()))) throw std::runtime_error("ls::serialize: write failed");
+			m_buffer.clear();
+		}
+	}
+
+	//BINARY_READER
+	inline void binary_reader::read( void * data, std::size_t count ){
+		m_is.read(static_cast<char*>(data), std::streamsize(count));
+		if(std::size_t(m_is.gcount()) != count) throw std::runtime_error("ls::deserialize: unexpected end of stream");
+	}
+
+	//=======================================================================================
+
+	//SERIALIZE
+	template<typename T, typename Allocator, typename Stats>
+	void serialize( const list<T,Allocator,Stats> & seq, std::ostream & os ){
+		binary_writer out(os);
+
+		detail::binary_header header;
+		std::memset(static_cast<void*>(&header), 0, sizeof(header)); // No stray padding bytes in the stream.
+		std::memcpy(header.magic, detail::binary_magic, sizeof(header.magic));
+		header.byte_order = detail::binary_byte_order;
+		header.kind = detail::element_kind_of<T>();
+		header.element = detail::element_size_of<T>();
+		header.count = std::uint64_t(seq.size());
+		out.write(&header, sizeof(header));
+
+		for(auto i(seq.cbegin()); i != seq.cend(); ++i){
+			binary_codec<T>::write(out, *i);
+		}
+		out.flush();
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	void deserialize( std::istream & is, list<T,Allocator,Stats> & seq ){
+		binary_reader in(is);
+
+		detail::binary_header header;
+		in.read(&header, sizeof(header));
+		if(std::memcmp(header.magic, detail::binary_magic, sizeof(header.magic)) != 0) throw std::runtime_error("ls::deserialize: not a serialized list");
+		if(header.byte_order != detail::binary_byte_order) throw std::runtime_error("ls::deserialize: written with another byte order");
+		if(header.kind != detail::element_kind_of<T>() || header.element != detail::element_size_of<T>()) throw std::runtime_error("ls::deserialize: written for another element type");
+		if(header.count > std::uint64_t( std::numeric_limits<int>::max() ) - std::uint64_t(seq.size())) throw std::runtime_error("ls::deserialize: too many elements");
+
+		// Built apart and spliced in at the end, so seq is untouched on failure.
+		list<T,Allocator,Stats> temp(seq.get_allocator());
+		std::uint64_t left = header.count;
+
+		if constexpr(std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value){
+			// Existing T objects, whose bytes are overwritten as trivially copyable allows.
+			std::vector<T> block( std::max<std::size_t>(1, binary_reader::capacity / sizeof(T)) );
+
+			while(left > 0){
+				std::size_t step = std::size_t( std::min<std::uint64_t>(left, block.size()) );
+				in.read(block.data(), step * sizeof(T));
+				temp.insert(temp.cend(), block.data(), block.data() + step);
+				left -= step;
+			}
+		}else{
+			for(; left > 0; --left){
+				temp.push_back( binary_codec<T>::read(in) );
+			}
+		}
+
+		seq.splice(seq.cend(), temp);
+	}
+
+	//=======================================================================================
+
+	//TEXT
+	template<typename T, typename Allocator, typename Stats>
+	void write_text( std::ostream & os, const list<T,Allocator,Stats> & seq, char sep ){
+		if constexpr(detail::fast_text<T>){
+			thread_local std::vector<char> buffer;
+			buffer.resize(detail::text_block);
+
+			char *first = buffer.data();
+			char *last = first + buffer.size();
+			char *out = first;
+
+			for(auto i(seq.cbegin()); i != seq.cend(); ++i){
+				if(std::size_t(last - out) < detail::text_room){
+					if(!os.write(first, out - first)) throw std::runtime_error("ls::write_text: write failed");
+					out = first;
+				}
+				out = std::to_chars(out, last, *i).ptr;
+				*out++ = sep;
+			}
+
+			if(!os.write(first, out - first)) throw std::runtime_error("ls::write_text: write failed");
+		}else{
+			for(auto i(seq.cbegin()); i != seq.cend(); ++i){
+				os << *i << sep;
+			}
+			if(!os) throw std::runtime_error("ls::write_text: write failed");
+		}
+	}
+
+	template<typename T, typename Allocator, typename Stats>
+	int read_text( std::istream & is, list<T,Allocator,Stats> & seq ){
+		// Built apart and spliced in at the end, so seq is untouched on failure.
+		list<T,Allocator,Stats> temp(seq.get_allocator());
+
+		if constexpr(detail::fast_text<T>){
+			std::vector<char> buffer(detail::text_block);
+			std::size_t kept = 0; // Bytes of a value cut by the end of the last block.
+			bool done = false;
+
+			while(!done){
+				is.read(buffer.data() + kept, std::streamsize(buffer.size() - kept));
+				std::size_t end = kept + std::size_t(is.gcount());
+				done = !is;
+
+				const char *p = buffer.data();
+				const char *stop = p + end;
+				kept = 0;
+
+				while(true){
+					while(p != stop && detail::is_space(*p)) ++p;
+					if(p == stop) break;
+
+					const char *token = p;
+					while(p != stop && !detail::is_space(*p)) ++p;
+
+					if(p == stop && !done){
+						// The value may go on in the next block.
+						kept = std::size_t(stop - token);
+						if(kept == buffer.size()){
+							is.setstate(std::ios_base::failbit);
+							return 0;
+						}
+						std::memmove(buffer.data(), token, kept);
+						break;
+					}
+
+					T value;
+					auto result = std::from_chars(token, p, value);
+					if(result.ec != std::errc() || result.ptr != p){
+						is.setstate(std::ios_base::failbit);
+						return 0;
+					}
+					temp.push_back(value);
+				}
+			}
+
+			// Reaching the end of the stream is what ends the input, not a failure.
+			if(is.eof()) is.clear(std::ios_base::eofbit);
+		}else{
+			T value;
+			while(is >> value){
+				temp.push_back(std::move(value));
+			}
+			if(!is.eof()) return 0;
+			is.clear(std::ios_base::eofbit);
+		}
+
+		int count = temp.size();
+		seq.splice(seq.cend(), temp);
+		return count;
+	}
+}
+
+#endif
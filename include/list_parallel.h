@@ -0,0 +1,95 @@
+#ifndef LIST_PARALLEL_H
+#define LIST_PARALLEL_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "list.h"
+#include "parallel.h"
+
+namespace ls{
+namespace parallel{
+
+	/* <! Sorts seq on several threads: the chain is cut into one sublist per thread, each is sorted
+		by relinking and the sorted runs are merged pairwise in parallel. Stable; nodes are only
+		relinked, T is never copied or moved. comp is copied per thread and must not throw.
+		Lists too short to be worth a thread each are sorted with list::sort.
+		@param pool The threads to use; the calling thread works too.
+	*/
+	template<typename T, typename Allocator, typename Stats, typename Compare>
+	void sort( thread_pool & pool, list<T,Allocator,Stats> & seq, Compare comp );
+
+	template<typename T, typename Allocator, typename Stats>
+	void sort( thread_pool & pool, list<T,Allocator,Stats> & seq ){ sort(pool, seq, std::less<T>()); }
+
+	/* <! Sorts seq by comp on the shared thread pool. */
+	template<typename T, typename Allocator, typename Stats, typename Compare>
+	void sort( list<T,Allocator,Stats> & seq, Compare comp ){ sort(thread_pool::shared(), seq, comp); }
+
+	/* <! Sorts seq on the shared thread pool. */
+	template<typename T, typename Allocator, typename Stats>
+	void sort( list<T,Allocator,Stats> & seq ){ sort(thread_pool::shared(), seq, std::less<T>()); }
+
+	/* <! Friend of ls::list, so the sort can work on the bare chain. */
+	struct chain_sorter{
+		template<typename T, typename Allocator, typename Stats, typename Compare>
+		static void sort( thread_pool & pool, list<T,Allocator,Stats> & seq, Compare comp );
+	};
+
+	//=======================================================================================
+
+	template<typename T, typename Allocator, typename Stats, typename Compare>
+	void sort( thread_pool & pool, list<T,Allocator,Stats> & seq, Compare comp ){
+		chain_sorter::sort(pool, seq, comp);
+	}
+
+	template<typename T, typename Allocator, typename Stats, typename Compare>
+	void chain_sorter::sort( thread_pool & pool, list<T,Allocator,Stats> & seq, Compare comp ){
+		typedef typename list<T,Allocator,Stats>::NodeBase NodeBase;
+
+		int runs = std::min( int(pool.size()) + 1, seq.m_size / grain );
+		if(runs < 2){
+			seq.sort(comp);
+			return;
+		}
+
+		// Cut the chain into runs null-terminated sublists of near equal length.
+		std::vector<NodeBase*> heads(runs);
+		NodeBase *temp = seq.m_sentinel.next;
+		for(int r = 0; r < runs; ++r){
+			heads[r] = temp;
+			int length = seq.m_size / runs + (r < seq.m_size % runs ? 1 : 0);
+			for(int i = 1; i < length; ++i){
+				temp = temp->next;
+			}
+			NodeBase *next = temp->next;
+			temp->next = nullptr;
+			temp = next;
+		}
+
+		pool.run( runs, [&]( int r ){
+			Compare local(comp);
+			heads[r] = list<T,Allocator,Stats>::sort_chain(heads[r], local);
+		} );
+
+		// Merge neighbouring runs pairwise, halving their number every round.
+		for(int step = 1; step < runs; step *= 2){
+			int pairs = (runs + 2 * step - 1) / (2 * step);
+			pool.run( pairs, [&, step]( int p ){
+				int a = 2 * step * p;
+				int b = a + step;
+				if(b < runs){
+					Compare local(comp);
+					heads[a] = list<T,Allocator,Stats>::merge_chains(heads[a], heads[b], local);
+				}
+			} );
+		}
+
+		seq.relink(heads[0]);
+		seq.forget();
+	}
+}
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef LIST_STATS_H
+#define LIST_STATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+
+namespace ls{
+	/* <! Counters of a list, or of every instrumented list of the process. */
+	struct list_stats_snapshot{
+		std::size_t allocations = 0; //<! Nodes allocated.
+		std::size_t frees = 0;       //<! Nodes freed.
+		std::size_t steps = 0;       //<! Links followed by advance_to, next, find and iterator + and -.
+		std::size_t finds = 0;       //<! Calls to find.
+		std::size_t find_probes = 0; //<! Elements compared by find.
+		std::size_t find_hits = 0;   //<! Calls to find that found their value.
+		std::size_t end_erases = 0;  //<! Calls to erase(pos) with pos == end(), which do nothing.
+	};
+
+	/* <! Formats s as a JSON object, one field per counter. */
+	inline std::string to_json( const list_stats_snapshot & s ){
+		std::string out("{");
+		auto field = [&out]( const char * name, std::size_t value, bool last ){
+			out += "\"";
+			out += name;
+			out += "\": ";
+			out += std::to_string(value);
+			if(!last) out += ", ";
+		};
+
+		field("allocations", s.allocations, false);
+		field("frees", s.frees, false);
+		field("steps", s.steps, false);
+		field("finds", s.finds, false);
+		field("find_probes", s.find_probes, false);
+		field("find_hits", s.find_hits, false);
+		field("end_erases", s.end_erases, true);
+		out += "}";
+		return out;
+	}
+
+	/* <! Stats policy of ls::list that records nothing. Every hook is an empty inline function and the
+		object is empty, so a list with this policy compiles to the same code as one without it.
+	*/
+	struct no_stats{
+		static constexpr bool enabled = false;
+
+		void allocated( std::size_t = 1 ) noexcept { /*empty*/ }
+		void freed( std::size_t = 1 ) noexcept { /*empty*/ }
+		void stepped( std::size_t ) noexcept { /*empty*/ }
+		void searched( std::size_t, bool ) noexcept { /*empty*/ }
+		void erased_end() noexcept { /*empty*/ }
+
+		/* <! Steps of an iterator, which does not know its list. */
+		static void iterator_stepped( std::size_t ) noexcept { /*empty*/ }
+
+		list_stats_snapshot snapshot() const noexcept { return list_stats_snapshot(); }
+	};
+
+	/* <! Stats policy of ls::list that counts, for each list and for the whole process.
+		All the counters are relaxed atomics: const lookups update them too, and those may run on
+		several threads at once. The process-wide ones are shared by every list with this policy.
+		A copied or moved list starts from zero.
+		Iterator + and - only reach the process-wide steps, since an iterator does not know its list.
+	*/
+	class counting_stats{
+		public:
+			static constexpr bool enabled = true;
+
+			counting_stats() = default;
+			counting_stats( const counting_stats & ) noexcept { /*empty*/ }
+			counting_stats & operator= ( const counting_stats & ) noexcept { return *this; }
+
+			void allocated( std::size_t count = 1 ) noexcept { add(m_local.allocations, count); add(totals().allocations, count); }
+			void freed( std::size_t count = 1 ) noexcept { add(m_local.frees, count); add(totals().frees, count); }
+			void stepped( std::size_t count ) noexcept { add(m_local.steps, count); add(totals().steps, count); }
+
+			/* <! One call to find that compared probes elements. */
+			void searched( std::size_t probes, bool hit ) noexcept{
+				for(atomic_counters *c : { &m_local, &totals() }){
+					add(c->finds, 1);
+					add(c->find_probes, probes);
+					add(c->steps, probes);
+					if(hit) add(c->find_hits, 1);
+				}
+			}
+
+			void erased_end() noexcept { add(m_local.end_erases, 1); add(totals().end_erases, 1); }
+
+			static void iterator_stepped( std::size_t count ) noexcept { add(totals().steps, count); }
+
+			/* <! Counters of this list. */
+			list_stats_snapshot snapshot() const noexcept { return load(m_local); }
+
+			/* <! Zeroes the counters of this list. */
+			void reset() noexcept { zero(m_local); }
+
+			/* <! Counters of every list with this policy, since the start or the last reset_global(). */
+			static list_stats_snapshot global() noexcept;
+
+			/* <! Zeroes the process-wide counters. */
+			static void reset_global() noexcept;
+
+		private:
+			struct atomic_counters{
+				std::atomic<std::size_t> allocations{0};
+				std::atomic<std::size_t> frees{0};
+				std::atomic<std::size_t> steps{0};
+				std::atomic<std::size_t> finds{0};
+				std::atomic<std::size_t> find_probes{0};
+				std::atomic<std::size_t> find_hits{0};
+				std::atomic<std::size_t> end_erases{0};
+			};
+
+			static atomic_counters & totals() noexcept{
+				static atomic_counters counters;
+				return counters;
+			}
+
+			static void add( std::atomic<std::size_t> & counter, std::size_t count ) noexcept{
+				counter.fetch_add(count, std::memory_order_relaxed);
+			}
+
+			static list_stats_snapshot load( const atomic_counters & t ) noexcept;
+			static void zero( atomic_counters & t ) noexcept;
+
+			atomic_counters m_local;
+	};
+
+	inline list_stats_snapshot counting_stats::global() noexcept{
+		return load(totals());
+	}
+
+	inline void counting_stats::reset_global() noexcept{
+		zero(totals());
+	}
+
+	inline list_stats_snapshot counting_stats::load( const atomic_counters & t ) noexcept{
+		list_stats_snapshot s;
+		s.allocations = t.allocations.load(std::memory_order_relaxed);
+		s.frees = t.frees.load(std::memory_order_relaxed);
+		s.steps = t.steps.load(std::memory_order_relaxed);
+		s.finds = t.finds.load(std::memory_order_relaxed);
+		s.find_probes = t.find_probes.load(std::memory_order_relaxed);
+		s.find_hits = t.find_hits.load(std::memory_order_relaxed);
+		s.end_erases = t.end_erases.load(std::memory_order_relaxed);
+		return s;
+	}
+
+	inline void counting_stats::zero( atomic_counters & t ) noexcept{
+		for(std::atomic<std::size_t> *c : { &t.allocations, &t.frees, &t.steps, &t.finds, &t.find_probes, &t.find_hits, &t.end_erases }){
+			c->store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+#endif
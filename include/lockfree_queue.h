@@ -0,0 +1,268 @@
+#ifndef LOCKFREE_QUEUE_H
+#define LOCKFREE_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "node_pool.h"
+
+namespace ls{
+	namespace detail{
+		/* <! Producer and consumer fields are kept on separate cache lines. */
+		constexpr std::size_t cache_line_size = 64;
+	}
+
+template<typename T, typename Allocator = pool_allocator<T> >
+
+	/* <! Unbounded FIFO for one producer thread and one consumer thread, without locks.
+		Nodes are linked like the nodes of ls::list, through an atomic next pointer. The consumer
+		only moves its tail forward; the nodes it leaves behind are picked up again by the producer,
+		so once the queue has grown to its working size push and pop allocate nothing.
+	*/
+	class spsc_queue
+	{
+		private:
+			/* <! A node that carries data. The data is built in place by the allocator. */
+			struct Node{
+				std::atomic<Node*> next; //<! Pointer to the next node in the queue.
+				T data;                  //<! Data field; alive only for the nodes after the tail.
+			};
+
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_allocator_type;
+			typedef std::allocator_traits<node_allocator_type> node_traits;
+
+		public:
+			typedef Allocator allocator_type;
+
+			spsc_queue() : spsc_queue( Allocator() ){ /*empty*/ }
+			explicit spsc_queue( const Allocator & alloc );
+			spsc_queue( const spsc_queue & ) = delete;
+			spsc_queue & operator= ( const spsc_queue & ) = delete;
+
+			/* <! Destroys the queue and whatever is left in it. Neither side may be using it. */
+			~spsc_queue();
+
+			/* <! Producer side. Adds a value at the back. */
+			void push( const T & value ){ emplace(value); }
+			void push( T && value ){ emplace(std::move(value)); }
+
+			/* <! Producer side. Builds a value in place at the back, in a recycled node if there is one. */
+			template<typename... Args>
+			void emplace( Args &&... args );
+
+			/* <! Consumer side. Removes the value at the front.
+				@return The value, or nothing if the queue was empty.
+			*/
+			std::optional<T> try_pop();
+
+			/* <! Consumer side. True if there is nothing to pop. */
+			bool empty() const { return m_tail.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire) == nullptr; }
+
+		private:
+			/* <! Producer side. Takes a consumed node back, or allocates one when none is left. */
+			Node * take_node();
+
+			alignas(detail::cache_line_size) std::atomic<Node*> m_tail; //<! Consumer: the last node consumed. Its data is dead.
+
+			alignas(detail::cache_line_size) Node *m_head;  //<! Producer: the last node pushed.
+			Node *m_first;                     //<! Producer: the oldest node not yet recycled.
+			Node *m_tail_copy;                 //<! Producer: m_tail as last seen; [m_first; m_tail_copy) is free.
+			node_allocator_type m_alloc;
+	};
+
+template<typename T, typename Allocator = pool_allocator<T> >
+
+	/* <! Unbounded FIFO for any number of producer threads and one consumer thread (Vyukov's
+		intrusive MPSC queue). Linking is lock-free: a push is one atomic exchange and one store,
+		a pop reads one atomic pointer. Every push allocates its node and every pop frees one
+		through the allocator, so the queue as a whole is only as lock-free as the allocator.
+		With the default pool_allocator, most calls hit the thread's own cache, but refilling or
+		handing back a batch of slots takes the depot mutex.
+		A pop may report an empty queue while a push is between its exchange and its store.
+	*/
+	class mpsc_queue
+	{
+		private:
+			/* <! Contains the next node address. The stub is a bare NodeBase. */
+			struct NodeBase{
+				std::atomic<NodeBase*> next; //<! Pointer to the next node in the queue.
+			};
+
+			/* <! A node that carries data. The data is built in place by the allocator. */
+			struct Node : NodeBase{
+				T data;     //<! Data field
+			};
+
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> node_allocator_type;
+			typedef std::allocator_traits<node_allocator_type> node_traits;
+
+		public:
+			typedef Allocator allocator_type;
+
+			mpsc_queue() : mpsc_queue( Allocator() ){ /*empty*/ }
+			explicit mpsc_queue( const Allocator & alloc );
+			mpsc_queue( const mpsc_queue & ) = delete;
+			mpsc_queue & operator= ( const mpsc_queue & ) = delete;
+
+			/* <! Destroys the queue and whatever is left in it. No thread may be using it. */
+			~mpsc_queue();
+
+			/* <! Any thread. Adds a value at the back. */
+			void push( const T & value ){ emplace(value); }
+			void push( T && value ){ emplace(std::move(value)); }
+
+			/* <! Any thread. Builds a value in place at the back. */
+			template<typename... Args>
+			void emplace( Args &&... args );
+
+			/* <! Consumer side. Removes the value at the front.
+				@return The value, or nothing if the queue was empty.
+			*/
+			std::optional<T> try_pop();
+
+			/* <! Consumer side. True if there is nothing to pop. */
+			bool empty() const { return m_tail->next.load(std::memory_order_acquire) == nullptr; }
+
+		private:
+			alignas(detail::cache_line_size) std::atomic<NodeBase*> m_head; //<! Producers: the last node pushed.
+
+			alignas(detail::cache_line_size) NodeBase *m_tail; //<! Consumer: the last node consumed. Its data is dead.
+			NodeBase m_stub;                      //<! The tail of an untouched queue.
+			node_allocator_type m_alloc;
+	};
+
+	//=======================================================================================
+
+	//SPSC_QUEUE
+	template<typename T, typename Allocator>
+	spsc_queue<T,Allocator>::spsc_queue( const Allocator & alloc ) : m_alloc(alloc){
+		Node *temp = node_traits::allocate(m_alloc, 1);
+		::new( static_cast<void*>( std::addressof(temp->next) ) ) std::atomic<Node*>(nullptr);
+
+		m_tail.store(temp, std::memory_order_relaxed);
+		m_head = temp;
+		m_first = temp;
+		m_tail_copy = temp;
+	}
+
+	template<typename T, typename Allocator>
+	spsc_queue<T,Allocator>::~spsc_queue(){
+		while( try_pop() ){ /*empty*/ }
+
+		// Every node, recycled or not, hangs from m_first.
+		Node *n = m_first;
+		while( n != nullptr ){
+			Node *next = n->next.load(std::memory_order_relaxed);
+			node_traits::deallocate(m_alloc, n, 1);
+			n = next;
+		}
+	}
+
+	template<typename T, typename Allocator>
+	typename spsc_queue<T,Allocator>::Node * spsc_queue<T,Allocator>::take_node(){
+		if( m_first == m_tail_copy ){
+			m_tail_copy = m_tail.load(std::memory_order_acquire);
+		}
+
+		if( m_first != m_tail_copy ){
+			Node *temp = m_first;
+			m_first = m_first->next.load(std::memory_order_relaxed);
+			return temp;
+		}
+
+		Node *temp = node_traits::allocate(m_alloc, 1);
+		::new( static_cast<void*>( std::addressof(temp->next) ) ) std::atomic<Node*>(nullptr);
+		return temp;
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	void spsc_queue<T,Allocator>::emplace( Args &&... args ){
+		Node *temp = take_node();
+
+		try{
+			node_traits::construct(m_alloc, std::addressof(temp->data), std::forward<Args>(args)...);
+		}catch(...){
+			// temp is no longer reachable from m_first.
+			node_traits::deallocate(m_alloc, temp, 1);
+			throw;
+		}
+
+		temp->next.store(nullptr, std::memory_order_relaxed);
+		m_head->next.store(temp, std::memory_order_release);
+		m_head = temp;
+	}
+
+	template<typename T, typename Allocator>
+	std::optional<T> spsc_queue<T,Allocator>::try_pop(){
+		Node *tail = m_tail.load(std::memory_order_relaxed);
+		Node *next = tail->next.load(std::memory_order_acquire);
+		if( next == nullptr ) return std::nullopt;
+
+		std::optional<T> value( std::move(next->data) );
+		node_traits::destroy(m_alloc, std::addressof(next->data));
+		// Hands tail over to the producer.
+		m_tail.store(next, std::memory_order_release);
+
+		return value;
+	}
+
+	//=======================================================================================
+
+	//MPSC_QUEUE
+	template<typename T, typename Allocator>
+	mpsc_queue<T,Allocator>::mpsc_queue( const Allocator & alloc ) : m_alloc(alloc){
+		m_stub.next.store(nullptr, std::memory_order_relaxed);
+		m_head.store(&m_stub, std::memory_order_relaxed);
+		m_tail = &m_stub;
+	}
+
+	template<typename T, typename Allocator>
+	mpsc_queue<T,Allocator>::~mpsc_queue(){
+		while( try_pop() ){ /*empty*/ }
+
+		if( m_tail != &m_stub ){
+			node_traits::deallocate(m_alloc, static_cast<Node*>(m_tail), 1);
+		}
+	}
+
+	template<typename T, typename Allocator>
+	template<typename... Args>
+	void mpsc_queue<T,Allocator>::emplace( Args &&... args ){
+		Node *temp = node_traits::allocate(m_alloc, 1);
+
+		try{
+			node_traits::construct(m_alloc, std::addressof(temp->data), std::forward<Args>(args)...);
+		}catch(...){
+			node_traits::deallocate(m_alloc, temp, 1);
+			throw;
+		}
+		::new( static_cast<void*>( std::addressof(temp->next) ) ) std::atomic<NodeBase*>(nullptr);
+
+		NodeBase *prev = m_head.exchange(temp, std::memory_order_acq_rel);
+		prev->next.store(temp, std::memory_order_release);
+	}
+
+	template<typename T, typename Allocator>
+	std::optional<T> mpsc_queue<T,Allocator>::try_pop(){
+		NodeBase *tail = m_tail;
+		NodeBase *next = tail->next.load(std::memory_order_acquire);
+		if( next == nullptr ) return std::nullopt;
+
+		Node *temp = static_cast<Node*>(next);
+		std::optional<T> value( std::move(temp->data) );
+		node_traits::destroy(m_alloc, std::addressof(temp->data));
+		m_tail = next;
+
+		if( tail != &m_stub ){
+			node_traits::deallocate(m_alloc, static_cast<Node*>(tail), 1);
+		}
+
+		return value;
+	}
+}
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "list.h"
+
+namespace ls{
+	/* <! Weighs every entry as 1: the capacity of the cache is a number of entries. */
+	struct unit_weight{
+		template<typename K, typename V>
+		std::size_t operator()( const K &, const V & ) const noexcept { return 1; }
+	};
+
+	/* <! Weighs every entry by the size of its key and value: the capacity is a number of bytes.
+		Write your own weigher for types that own memory elsewhere, such as strings.
+	*/
+	struct byte_weight{
+		template<typename K, typename V>
+		std::size_t operator()( const K &, const V & ) const noexcept { return sizeof(K) + sizeof(V); }
+	};
+
+	/* <! Counters of an lru_cache. */
+	struct lru_stats{
+		std::size_t hits = 0;      //<! get() calls that found their key.
+		std::size_t misses = 0;    //<! get() calls that did not.
+		std::size_t evictions = 0; //<! Entries dropped to make room.
+	};
+
+template<typename K, typename V, typename Weigh = unit_weight, typename Hash = std::hash<K>,
+	typename KeyEqual = std::equal_to<K>, typename Allocator = pool_allocator< std::pair<const K, V> > >
+
+	/* <! Least recently used cache. The entries live in an ls::list, most recent first, and a hash
+		map points from each key to its node. A hit relinks the node to the front; eviction takes the
+		node before the sentinel. get, put and erase cost O(1) on average and never copy an entry.
+		The capacity bounds the total weight of the entries, as measured by Weigh.
+	*/
+	class lru_cache
+	{
+		public:
+			typedef std::pair<const K, V> value_type;
+			typedef list<value_type, Allocator> list_type;
+			typedef typename list_type::const_iterator const_iterator;
+
+			/* <! Constructs an empty cache.
+				@param capacity Largest total weight kept: entries, or bytes with byte_weight.
+				@param weigh The weigher of the entries.
+			*/
+			explicit lru_cache( std::size_t capacity, Weigh weigh = Weigh() );
+
+			lru_cache( const lru_cache & ) = delete;
+			lru_cache & operator= ( const lru_cache & ) = delete;
+
+			//[I] ITERATORS
+			// From the most to the least recently used entry.
+			const_iterator begin() const { return m_list.cbegin(); }
+			const_iterator end() const { return m_list.cend(); }
+
+			//[II] CAPACITY
+			int size() const { return m_list.size(); }
+			bool empty() const { return m_list.empty(); }
+			std::size_t weight() const { return m_weight; }
+			std::size_t capacity() const { return m_capacity; }
+
+			/* <! Changes the capacity, evicting the least recently used entries that no longer fit. */
+			void set_capacity( std::size_t capacity );
+
+			//[III] LOOKUP
+
+			/* <! Looks key up and makes it the most recently used entry. Counts a hit or a miss.
+				@return The value, or nullptr. Valid until the entry is evicted or erased.
+			*/
+			V * get( const K & key );
+
+			/* <! Looks key up without touching the recency order or the counters. */
+			const V * peek( const K & key ) const;
+
+			bool contains( const K & key ) const { return m_index.find(key) != m_index.end(); }
+
+			//[IV] MODIFIERS
+
+			/* <! Inserts or replaces the value of key, as the most recently used entry, then evicts from
+				the least recently used end until the weight fits. An entry heavier than the whole capacity
+				is not kept and evicts nothing: a new key is rejected, and an existing key is erased.
+			*/
+			void put( const K & key, V value );
+
+			/* <! Removes key. Not counted as an eviction.
+				@return True if key was there.
+			*/
+			bool erase( const K & key );
+
+			void clear();
+
+			//[V] COUNTERS
+			const lru_stats & stats() const { return m_stats; }
+			void reset_stats(){ m_stats = lru_stats(); }
+
+		private:
+			/* <! The keys of the map point into the nodes, so each key is stored once. */
+			struct key_hash{
+				Hash hash;
+				std::size_t operator()( const K & key ) const { return hash(key); }
+			};
+
+			struct key_equal{
+				KeyEqual equal;
+				bool operator()( const K & a, const K & b ) const { return equal(a, b); }
+			};
+
+			typedef std::reference_wrapper<const K> key_ref;
+			typedef typename list_type::iterator iterator;
+			typedef std::pair<const key_ref, iterator> entry_type;
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<entry_type> index_allocator_type;
+			typedef std::unordered_map<key_ref, iterator, key_hash, key_equal, index_allocator_type> index_type;
+
+			/* <! Drops the least recently used entry. */
+			void evict();
+
+			/* <! Evicts until the weight fits in the capacity. */
+			void trim();
+
+			list_type m_list;
+			index_type m_index;
+			Weigh m_weigh;
+			std::size_t m_capacity;
+			std::size_t m_weight = 0;
+			lru_stats m_stats;
+	};
+
+	//=======================================================================================
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::lru_cache( std::size_t capacity, Weigh weigh ) : m_weigh(weigh), m_capacity(capacity){
+		/*empty*/
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	void lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::set_capacity( std::size_t capacity ){
+		m_capacity = capacity;
+		trim();
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	V * lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::get( const K & key ){
+		auto i = m_index.find(key);
+		if(i == m_index.end()){
+			m_stats.misses++;
+			return nullptr;
+		}
+
+		m_stats.hits++;
+		m_list.splice(m_list.cbegin(), m_list, i->second);
+		return &(*i->second).second;
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	const V * lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::peek( const K & key ) const{
+		auto i = m_index.find(key);
+		return (i == m_index.end()) ? nullptr : &(*i->second).second;
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	void lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::put( const K & key, V value ){
+		if(m_weigh(key, value) > m_capacity){
+			erase(key);
+			return;
+		}
+
+		auto i = m_index.find(key);
+
+		if(i != m_index.end()){
+			value_type &entry = *i->second;
+			m_weight -= m_weigh(entry.first, entry.second);
+			entry.second = std::move(value);
+			m_weight += m_weigh(entry.first, entry.second);
+			m_list.splice(m_list.cbegin(), m_list, i->second);
+		}else{
+			m_list.emplace_front(key, std::move(value));
+			try{
+				m_index.emplace( key_ref(m_list.front().first), m_list.begin() );
+			}catch(...){
+				m_list.pop_front();
+				throw;
+			}
+			m_weight += m_weigh(m_list.front().first, m_list.front().second);
+		}
+
+		trim();
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	bool lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::erase( const K & key ){
+		auto i = m_index.find(key);
+		if(i == m_index.end()) return false;
+
+		iterator node = i->second;
+		m_weight -= m_weigh((*node).first, (*node).second);
+		m_index.erase(i);
+		m_list.erase(node);
+
+		return true;
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	void lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::clear(){
+		m_index.clear();
+		m_list.clear();
+		m_weight = 0;
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	void lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::evict(){
+		const value_type &last = m_list.back();
+		m_weight -= m_weigh(last.first, last.second);
+		// The map key refers to the node: drop the entry before the node.
+		m_index.erase(last.first);
+		m_list.pop_back();
+		m_stats.evictions++;
+	}
+
+	template<typename K, typename V, typename Weigh, typename Hash, typename KeyEqual, typename Allocator>
+	void lru_cache<K,V,Weigh,Hash,KeyEqual,Allocator>::trim(){
+		while(m_weight > m_capacity && !m_list.empty()){
+			evict();
+		}
+	}
+}
+
+#endif
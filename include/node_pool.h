@@ -0,0 +1,393 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ls{
+template<std::size_t Size, std::size_t Align>
+
+	/* <! Slab allocator for objects of one fixed size. Slots are carved out of large blocks and
+		recycled through an intrusive free list. Every thread owns its own pool, so allocate and
+		deallocate never lock; a slot may be released by a thread other than the one that produced it.
+		Blocks are kept for the whole life of the process and are never given back to the system.
+	*/
+	class node_pool
+	{
+		static_assert( Align <= alignof(std::max_align_t), "over-aligned slots are not supported" );
+
+		public:
+			/* <! Alignment of one slot: that of the objects, or of the free list link a free slot holds. */
+			static constexpr std::size_t slot_align = Align < alignof(void*) ? alignof(void*) : Align;
+
+			/* <! Size in bytes of one slot, a multiple of slot_align so every slot in a block is aligned. */
+			static constexpr std::size_t slot_size = ( ( Size < sizeof(void*) ? sizeof(void*) : Size ) + slot_align - 1 ) / slot_align * slot_align;
+
+			/* <! Returns the pool of the calling thread. Not to be called once that pool is destroyed
+				at thread exit; allocate_slot and deallocate_slot handle that case.
+			*/
+			static node_pool & local();
+
+			/* <! Takes one slot from the calling thread's pool, or straight from the depot once that
+				pool is destroyed, as happens for static objects destroyed at exit.
+			*/
+			static void * allocate_slot();
+
+			/* <! Gives one slot back to the calling thread's pool, or straight to the depot once that
+				pool is destroyed.
+			*/
+			static void deallocate_slot( void * p );
+
+			/* <! Takes count slots lying next to each other, slot_size bytes apart, from the calling
+				thread's pool, or from a block of their own once that pool is destroyed.
+				Each slot is given back on its own.
+				@return The first slot of the run.
+			*/
+			static void * allocate_run( std::size_t count );
+
+			/* <! Takes one slot from the pool.
+				@return Uninitialized memory for one object of Size bytes.
+			*/
+			void * allocate();
+
+			/* <! Carves count adjacent slots out of the current block, or of a new one large enough.
+				What is left of the current block in that case goes to the free list.
+			*/
+			void * allocate_contiguous( std::size_t count );
+
+			/* <! Gives one slot back to the pool.
+				@param p Pointer returned by a previous allocate(), possibly of another thread.
+			*/
+			void deallocate( void * p );
+
+			/* <! Hands the cached slots back to the shared depot. */
+			~node_pool();
+
+		private:
+			/* <! A free slot, linked into the free list. */
+			struct Slot{
+				Slot *next; //<! Next free slot.
+			};
+			static_assert( alignof(Slot) <= slot_align, "free slots must be able to hold their link" );
+
+			/* <! A chain of free slots moved between a pool and the depot in one piece. */
+			struct Batch{
+				Slot *first;       //<! Head of the chain.
+				Slot *last;        //<! Tail of the chain.
+				std::size_t count; //<! Slots in the chain.
+			};
+
+			/* <! Shared by all the threads: idle batches and every block ever allocated. */
+			struct Depot{
+				std::mutex lock;            //<! Guards the other fields.
+				std::vector<Batch> batches; //<! Slots given back by the pools.
+				std::vector<void*> blocks;  //<! Kept so the blocks stay reachable.
+			};
+
+			static constexpr std::size_t first_block_slots = 64;   //<! Slots in the first block.
+			static constexpr std::size_t max_block_slots = 8192;   //<! Slots in the largest block.
+			static constexpr std::size_t max_cached = 2 * max_block_slots; //<! Free slots a pool keeps.
+
+			node_pool() = default;
+			node_pool( const node_pool & ) = delete;
+			node_pool & operator= ( const node_pool & ) = delete;
+
+			static Depot & depot();
+
+			/* <! Fills the free list from the depot or from a new block. */
+			void refill();
+
+			/* <! Makes a new block of slots the current one. d.lock must be held. */
+			void add_block( Depot & d, std::size_t slots );
+
+			/* <! Moves the whole free list to the depot. */
+			void give_back();
+
+			/* <! Set when the calling thread's pool is destroyed. Trivially destructible, so it can still
+				be read after the pool itself is gone.
+			*/
+			static thread_local bool s_retired;
+
+			Slot *m_free = nullptr;                   //<! Local free list.
+			Slot *m_last = nullptr;                   //<! Tail of the local free list.
+			std::size_t m_cached = 0;                 //<! Slots in the local free list.
+			char *m_cursor = nullptr;                 //<! Next slot to carve in the current block.
+			char *m_limit = nullptr;                  //<! End of the current block.
+			std::size_t m_block_slots = first_block_slots;
+	};
+
+	//=======================================================================================
+
+	template<std::size_t Size, std::size_t Align>
+	thread_local bool node_pool<Size,Align>::s_retired = false;
+
+	template<std::size_t Size, std::size_t Align>
+	node_pool<Size,Align> & node_pool<Size,Align>::local(){
+		static thread_local node_pool pool;
+		return pool;
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	typename node_pool<Size,Align>::Depot & node_pool<Size,Align>::depot(){
+		// Never destroyed: slots may still be in use by static objects at exit.
+		static Depot *d = new Depot();
+		return *d;
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void * node_pool<Size,Align>::allocate_slot(){
+		if( not s_retired ){
+			return local().allocate();
+		}
+
+		Depot &d = depot();
+		std::lock_guard<std::mutex> guard(d.lock);
+
+		if( not d.batches.empty() ){
+			Batch &b = d.batches.back();
+			Slot *s = b.first;
+			b.first = s->next;
+			if( --b.count == 0 ){
+				d.batches.pop_back();
+			}
+			return s;
+		}
+
+		d.blocks.reserve( d.blocks.size() + 1 );
+		void *p = ::operator new(slot_size);
+		d.blocks.push_back(p);
+		return p;
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void node_pool<Size,Align>::deallocate_slot( void * p ){
+		if( not s_retired ){
+			local().deallocate(p);
+			return;
+		}
+
+		Slot *s = static_cast<Slot*>(p);
+		s->next = nullptr;
+
+		Depot &d = depot();
+		std::lock_guard<std::mutex> guard(d.lock);
+		d.batches.push_back( Batch{ s, s, 1 } );
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void * node_pool<Size,Align>::allocate_run( std::size_t count ){
+		if( not s_retired ){
+			return local().allocate_contiguous(count);
+		}
+
+		Depot &d = depot();
+		std::lock_guard<std::mutex> guard(d.lock);
+		d.blocks.reserve( d.blocks.size() + 1 );
+		void *p = ::operator new(count * slot_size);
+		d.blocks.push_back(p);
+		return p;
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void * node_pool<Size,Align>::allocate(){
+		if( m_free == nullptr ){
+			if( m_cursor == m_limit ){
+				refill();
+			}
+
+			if( m_free == nullptr ){
+				void *p = m_cursor;
+				m_cursor += slot_size;
+				return p;
+			}
+		}
+
+		Slot *s = m_free;
+		m_free = s->next;
+		m_cached--;
+
+		return s;
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void node_pool<Size,Align>::deallocate( void * p ){
+		Slot *s = static_cast<Slot*>(p);
+
+		if( m_free == nullptr ){
+			m_last = s;
+		}
+		s->next = m_free;
+		m_free = s;
+
+		// A consumer thread that only frees would otherwise hoard slots forever.
+		if( ++m_cached == max_cached ){
+			give_back();
+		}
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void * node_pool<Size,Align>::allocate_contiguous( std::size_t count ){
+		if( std::size_t(m_limit - m_cursor) < count * slot_size ){
+			char *tail = m_cursor;
+			char *end = m_limit;
+			{
+				Depot &d = depot();
+				std::lock_guard<std::mutex> guard(d.lock);
+				add_block( d, count < m_block_slots ? m_block_slots : count );
+			}
+
+			// The uncarved end of the old block is not lost: it goes to the free list.
+			for( ; tail != end; tail += slot_size ){
+				deallocate(tail);
+			}
+		}
+
+		void *p = m_cursor;
+		m_cursor += count * slot_size;
+		return p;
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void node_pool<Size,Align>::refill(){
+		Depot &d = depot();
+		std::lock_guard<std::mutex> guard(d.lock);
+
+		if( not d.batches.empty() ){
+			Batch b = d.batches.back();
+			d.batches.pop_back();
+
+			m_free = b.first;
+			m_last = b.last;
+			m_cached = b.count;
+			return;
+		}
+
+		add_block(d, m_block_slots);
+
+		if( m_block_slots < max_block_slots ){
+			m_block_slots *= 2;
+		}
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void node_pool<Size,Align>::add_block( Depot & d, std::size_t slots ){
+		const std::size_t bytes = slots * slot_size;
+		d.blocks.reserve( d.blocks.size() + 1 );
+		m_cursor = static_cast<char*>( ::operator new(bytes) );
+		m_limit = m_cursor + bytes;
+		d.blocks.push_back(m_cursor);
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	void node_pool<Size,Align>::give_back(){
+		if( m_free == nullptr ) return;
+
+		Depot &d = depot();
+		std::lock_guard<std::mutex> guard(d.lock);
+		d.batches.push_back( Batch{ m_free, m_last, m_cached } );
+
+		m_free = nullptr;
+		m_last = nullptr;
+		m_cached = 0;
+	}
+
+	template<std::size_t Size, std::size_t Align>
+	node_pool<Size,Align>::~node_pool(){
+		// The uncarved end of the current block goes back as free slots too.
+		while( m_cursor != m_limit ){
+			deallocate(m_cursor);
+			m_cursor += slot_size;
+		}
+
+		give_back();
+		s_retired = true;
+	}
+
+	//=======================================================================================
+
+	/* <! Stateless allocator that takes single objects from the node_pool of their size.
+		Arrays and over-aligned types fall back to operator new. All instances compare equal,
+		so memory allocated by one can be released by any other.
+	*/
+	template<typename T>
+	class pool_allocator
+	{
+		public:
+			typedef T value_type;
+
+			pool_allocator() noexcept = default;
+
+			template<typename U>
+			pool_allocator( const pool_allocator<U> & ) noexcept { /*empty*/ }
+
+			/* <! Allocates storage for n objects of T.
+				@param n Number of objects.
+				@return Uninitialized storage.
+			*/
+			T * allocate( std::size_t n );
+
+			/* <! Allocates count single objects of T in adjacent storage, by increasing address.
+				Each one is released on its own, with deallocate(p, 1).
+			*/
+			void allocate_run( T ** out, std::size_t count );
+
+			/* <! Releases storage returned by allocate(n). */
+			void deallocate( T * p, std::size_t n ) noexcept;
+
+		private:
+			typedef node_pool<sizeof(T), alignof(T)> pool_type;
+			static constexpr bool pooled = alignof(T) <= alignof(std::max_align_t);
+	};
+
+	template<typename T>
+	T * pool_allocator<T>::allocate( std::size_t n ){
+		if constexpr( pooled ){
+			if( n == 1 ) return static_cast<T*>( pool_type::allocate_slot() );
+		}
+		return static_cast<T*>( ::operator new( n * sizeof(T), std::align_val_t(alignof(T)) ) );
+	}
+
+	template<typename T>
+	void pool_allocator<T>::allocate_run( T ** out, std::size_t count ){
+		if constexpr( pooled ){
+			char *p = static_cast<char*>( pool_type::allocate_run(count) );
+			for( std::size_t i = 0; i < count; ++i ){
+				out[i] = static_cast<T*>( static_cast<void*>( p + i * pool_type::slot_size ) );
+			}
+		}else{
+			for( std::size_t i = 0; i < count; ++i ){
+				try{
+					out[i] = allocate(1);
+				}catch(...){
+					while( i > 0 ) deallocate( out[--i], 1 );
+					throw;
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void pool_allocator<T>::deallocate( T * p, std::size_t n ) noexcept{
+		if constexpr( pooled ){
+			if( n == 1 ){
+				pool_type::deallocate_slot(p);
+				return;
+			}
+		}
+		::operator delete( p, std::align_val_t(alignof(T)) );
+	}
+
+	template<typename T, typename U>
+	bool operator==( const pool_allocator<T> &, const pool_allocator<U> & ) noexcept{
+		return true;
+	}
+
+	template<typename T, typename U>
+	bool operator!=( const pool_allocator<T> &, const pool_allocator<U> & ) noexcept{
+		return false;
+	}
+}
+
+#endif
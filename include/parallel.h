@@ -0,0 +1,285 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ls{
+namespace parallel{
+
+	/* <! Fixed set of worker threads fed from one task queue. */
+	class thread_pool
+	{
+		public:
+			/* <! Starts workers threads; zero is allowed, then the callers do all the work. */
+			explicit thread_pool( unsigned workers );
+			thread_pool( const thread_pool & ) = delete;
+			thread_pool & operator= ( const thread_pool & ) = delete;
+
+			/* <! Finishes the queued tasks and joins the workers. */
+			~thread_pool();
+
+			/* <! Pool shared by the algorithms below: one worker per core, minus the calling thread. */
+			static thread_pool & shared();
+
+			/* <! Number of worker threads. */
+			unsigned size() const { return unsigned( m_workers.size() ); }
+
+			/* <! Queues a task for the workers. */
+			void submit( std::function<void()> task );
+
+			/* <! Runs body(0) ... body(count-1), spread over the workers and the calling thread.
+				The calling thread takes chunks too, so it is safe to call from inside a task.
+				The first exception thrown by body is rethrown once every chunk is finished.
+			*/
+			template<typename Body>
+			void run( int count, Body body );
+
+		private:
+			void work();
+
+			std::vector<std::thread> m_workers;
+			std::deque<std::function<void()>> m_tasks;
+			std::mutex m_lock;               //<! Guards m_tasks and m_stop.
+			std::condition_variable m_ready; //<! Signalled when a task is queued or the pool stops.
+			bool m_stop = false;
+	};
+
+	/* <! Fewest elements worth a chunk of their own. */
+	constexpr int grain = 4096;
+
+	/* <! Cuts [first; last), of size elements, into at most chunks ranges of near equal length,
+		in one pass.
+		@return The chunk boundaries, first and last included.
+	*/
+	template<typename Iterator>
+	std::vector<Iterator> split( Iterator first, Iterator last, int size, int chunks );
+
+	/* <! Number of chunks for size elements on pool. */
+	inline int chunks_for( const thread_pool & pool, int size ){
+		int by_grain = ( size + grain - 1 ) / grain;
+		int by_threads = 4 * int( pool.size() + 1 );
+		return std::max( 1, std::min( by_grain, by_threads ) );
+	}
+
+	/* <! Calls f on every element of seq, in parallel chunks. */
+	template<typename List, typename F>
+	void for_each( thread_pool & pool, List & seq, F f );
+
+	template<typename List, typename F>
+	void for_each( List & seq, F f ){ for_each(thread_pool::shared(), seq, f); }
+
+	/* <! Replaces every element x of seq with f(x), in parallel chunks. */
+	template<typename List, typename F>
+	void transform_inplace( thread_pool & pool, List & seq, F f );
+
+	template<typename List, typename F>
+	void transform_inplace( List & seq, F f ){ transform_inplace(thread_pool::shared(), seq, f); }
+
+	/* <! Folds seq with op, starting from init. Chunks are folded in parallel and then combined in order,
+		so op must be associative; it need not be commutative.
+	*/
+	template<typename List, typename T, typename BinaryOp>
+	T reduce( thread_pool & pool, const List & seq, T init, BinaryOp op );
+
+	template<typename List, typename T, typename BinaryOp>
+	T reduce( const List & seq, T init, BinaryOp op ){ return reduce(thread_pool::shared(), seq, init, op); }
+
+	template<typename List, typename T>
+	T reduce( const List & seq, T init ){ return reduce(thread_pool::shared(), seq, init, std::plus<>()); }
+
+	/* <! Counts the elements of seq for which pred is true, in parallel chunks. */
+	template<typename List, typename Predicate>
+	int count_if( thread_pool & pool, const List & seq, Predicate pred );
+
+	template<typename List, typename Predicate>
+	int count_if( const List & seq, Predicate pred ){ return count_if(thread_pool::shared(), seq, pred); }
+
+	//=======================================================================================
+
+	//THREAD_POOL
+	inline thread_pool::thread_pool( unsigned workers ){
+		for( unsigned i = 0; i < workers; ++i ){
+			m_workers.emplace_back( [this]{ work(); } );
+		}
+	}
+
+	inline thread_pool::~thread_pool(){
+		{
+			std::lock_guard<std::mutex> guard(m_lock);
+			m_stop = true;
+		}
+		m_ready.notify_all();
+
+		for( auto &w : m_workers ){
+			w.join();
+		}
+	}
+
+	inline thread_pool & thread_pool::shared(){
+		static thread_pool pool( std::max( 1u, std::thread::hardware_concurrency() ) - 1 );
+		return pool;
+	}
+
+	inline void thread_pool::submit( std::function<void()> task ){
+		{
+			std::lock_guard<std::mutex> guard(m_lock);
+			m_tasks.push_back( std::move(task) );
+		}
+		m_ready.notify_one();
+	}
+
+	inline void thread_pool::work(){
+		for(;;){
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> guard(m_lock);
+				m_ready.wait( guard, [this]{ return m_stop || !m_tasks.empty(); } );
+				if( m_tasks.empty() ) return;
+
+				task = std::move( m_tasks.front() );
+				m_tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	template<typename Body>
+	void thread_pool::run( int count, Body body ){
+		if( count <= 0 ) return;
+
+		// Shared with the helpers, which may only get to run after the caller has returned.
+		struct Job{
+			std::atomic<int> next{ 0 };
+			int done = 0;
+			std::exception_ptr error;
+			std::mutex lock;
+			std::condition_variable finished;
+		};
+		auto job = std::make_shared<Job>();
+
+		auto drain = [job, count, &body]{
+			int i;
+			while( ( i = job->next.fetch_add(1, std::memory_order_relaxed) ) < count ){
+				try{
+					body(i);
+				}catch(...){
+					std::lock_guard<std::mutex> guard(job->lock);
+					if( !job->error ) job->error = std::current_exception();
+				}
+
+				std::lock_guard<std::mutex> guard(job->lock);
+				if( ++job->done == count ) job->finished.notify_all();
+			}
+		};
+
+		// body lives in this frame: helpers only touch it for chunks they took, all finished before we return.
+		unsigned helpers = std::min( size(), unsigned( count - 1 ) );
+		for( unsigned h = 0; h < helpers; ++h ){
+			submit(drain);
+		}
+		drain();
+
+		std::unique_lock<std::mutex> guard(job->lock);
+		job->finished.wait( guard, [&]{ return job->done == count; } );
+		if( job->error ) std::rethrow_exception(job->error);
+	}
+
+	//=======================================================================================
+
+	//ALGORITHMS
+	template<typename Iterator>
+	std::vector<Iterator> split( Iterator first, Iterator last, int size, int chunks ){
+		std::vector<Iterator> bounds;
+		bounds.reserve( chunks + 1 );
+		bounds.push_back(first);
+
+		// The first size % chunks chunks get one element more.
+		int base = size / chunks;
+		int extra = size % chunks;
+		for( int c = 1; c < chunks; ++c ){
+			int length = base + ( c <= extra ? 1 : 0 );
+			for( int i = 0; i < length; ++i ){
+				++first;
+			}
+			bounds.push_back(first);
+		}
+		bounds.push_back(last);
+
+		return bounds;
+	}
+
+	template<typename List, typename F>
+	void for_each( thread_pool & pool, List & seq, F f ){
+		int chunks = chunks_for(pool, seq.size());
+		auto bounds = split(seq.begin(), seq.end(), seq.size(), chunks);
+
+		pool.run( chunks, [&]( int c ){
+			for( auto i(bounds[c]); i != bounds[c + 1]; ++i ){
+				f(*i);
+			}
+		} );
+	}
+
+	template<typename List, typename F>
+	void transform_inplace( thread_pool & pool, List & seq, F f ){
+		for_each( pool, seq, [&f]( auto & x ){ x = f(x); } );
+	}
+
+	template<typename List, typename T, typename BinaryOp>
+	T reduce( thread_pool & pool, const List & seq, T init, BinaryOp op ){
+		if( seq.size() == 0 ) return init;
+
+		int chunks = chunks_for(pool, seq.size());
+		auto bounds = split(seq.cbegin(), seq.cend(), seq.size(), chunks);
+		std::vector<std::unique_ptr<T>> partial( chunks );
+
+		// Every chunk is non-empty, so it starts from its own first element.
+		pool.run( chunks, [&]( int c ){
+			auto i(bounds[c]);
+			T acc( *i );
+			for( ++i; i != bounds[c + 1]; ++i ){
+				acc = op( std::move(acc), *i );
+			}
+			partial[c].reset( new T( std::move(acc) ) );
+		} );
+
+		for( auto &p : partial ){
+			init = op( std::move(init), std::move(*p) );
+		}
+		return init;
+	}
+
+	template<typename List, typename Predicate>
+	int count_if( thread_pool & pool, const List & seq, Predicate pred ){
+		int chunks = chunks_for(pool, seq.size());
+		auto bounds = split(seq.cbegin(), seq.cend(), seq.size(), chunks);
+		std::vector<int> partial( chunks, 0 );
+
+		pool.run( chunks, [&]( int c ){
+			int count = 0;
+			for( auto i(bounds[c]); i != bounds[c + 1]; ++i ){
+				if( pred(*i) ) count++;
+			}
+			partial[c] = count;
+		} );
+
+		int count = 0;
+		for( int p : partial ){
+			count += p;
+		}
+		return count;
+	}
+}
+}
+
+#endif
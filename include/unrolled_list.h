@@ -0,0 +1,672 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "node_pool.h"
+
+namespace ls{
+template<typename T, std::size_t BlockBytes = 256, typename Allocator = pool_allocator<T> >
+
+	/* <! Unrolled doubly linked list: every node holds a small array of elements and a fill count,
+		so a scan touches contiguous memory instead of one node per element. Blocks split when an
+		insertion finds them full and merge with a neighbour when erasing leaves both under half full.
+		Insertions and erasures invalidate the iterators into the blocks they touch.
+	*/
+	class unrolled_list
+	{
+		private:
+			/* <! Contains the previous and next block adresses and the fill count. The sentinel is a bare BlockBase. */
+			struct BlockBase{
+				BlockBase *prev; //<! Pointer to the previous block in the list.
+				BlockBase *next; //<! Pointer to the next block in the list.
+				int count;       //<! Number of elements stored in the block.
+			};
+
+		public:
+			/* <! Number of elements held by one block. */
+			static constexpr int capacity = ( BlockBytes > sizeof(BlockBase) + sizeof(T) ) ?
+				int( ( BlockBytes - sizeof(BlockBase) ) / sizeof(T) ) : 1;
+
+		private:
+			/* <! A block with room for capacity elements; only the first count are alive. */
+			struct Block : BlockBase{
+				alignas(T) unsigned char storage[ capacity * sizeof(T) ]; //<! Elements.
+			};
+
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Block> block_allocator_type;
+			typedef std::allocator_traits<block_allocator_type> block_traits;
+
+		public:
+			typedef Allocator allocator_type;
+
+			/* <! A simple const_iterator class: a block and an index into it. */
+			class const_iterator{
+				public:
+					typedef const T& const_reference;
+					typedef const T* const_pointer;
+					typedef std::ptrdiff_t difference_type;
+
+					/* <! Default const_iterator initializer. */
+					const_iterator() = default;
+
+					/* <! Default const_iterator deferencier.
+						@return value of it.
+					*/
+					const_reference operator*() const { return *unrolled_list::slot(block, index); }
+					const_pointer operator->() const { return unrolled_list::slot(block, index); }
+
+					const_iterator & operator++();   // ++it;
+					const_iterator operator++(int);  // it++;
+					const_iterator & operator--();   // --it;
+					const_iterator operator--(int);  // it--;
+
+					/* <! Returns a const_iterator add positions ahead. Skips whole blocks. */
+					const_iterator operator+(int add) const;
+					/* <! Returns a const_iterator sub positions behind. */
+					const_iterator operator-(int sub) const;
+
+					bool operator==(const const_iterator &rhs) const { return block == rhs.block && index == rhs.index; }
+					bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+
+				protected:
+					BlockBase *block = nullptr;
+					int index = 0;
+					const_iterator(BlockBase *b, int i) : block(b), index(i){ /*empty*/ }
+
+					friend class unrolled_list;
+			};
+
+			class iterator : public const_iterator{
+				public:
+					typedef T& reference;
+					typedef T* pointer;
+
+					iterator() : const_iterator() { /*empty*/ }
+
+					reference operator*() const { return *unrolled_list::slot(this->block, this->index); }
+					pointer operator->() const { return unrolled_list::slot(this->block, this->index); }
+
+					iterator & operator++(){ const_iterator::operator++(); return *this; }
+					iterator operator++(int){ iterator temp(*this); const_iterator::operator++(); return temp; }
+					iterator & operator--(){ const_iterator::operator--(); return *this; }
+					iterator operator--(int){ iterator temp(*this); const_iterator::operator--(); return temp; }
+
+					iterator operator+(int add) const { return iterator(const_iterator::operator+(add)); }
+					iterator operator-(int sub) const { return iterator(const_iterator::operator-(sub)); }
+
+				protected:
+					iterator(BlockBase *b, int i) : const_iterator(b, i){ /*empty*/ }
+					explicit iterator(const const_iterator &it) : const_iterator(it){ /*empty*/ }
+
+					friend class unrolled_list;
+			};
+
+			// [I] SPECIAL MEMBERS
+			unrolled_list() : unrolled_list( Allocator() ){ /*empty*/ }
+
+			/* <! Constructs an empty list that allocates through alloc. */
+			explicit unrolled_list( const Allocator & alloc );
+
+			/* <! Constructs the list with the contents of the range [first,last). */
+			template<typename InputIt>
+			unrolled_list( InputIt first, InputIt last, const Allocator & alloc = Allocator() );
+
+			/* <! Constructs the list with the contents of the initializer list ilist. */
+			unrolled_list( std::initializer_list<T> ilist, const Allocator & alloc = Allocator() );
+
+			/* <! Copy constructs. Blocks of the copy are filled up. */
+			unrolled_list( const unrolled_list & other );
+
+			/* <! Move constructs. Takes the blocks of other in O(1). */
+			unrolled_list( unrolled_list && other ) noexcept;
+
+			~unrolled_list();
+
+			unrolled_list & operator= ( const unrolled_list & other );
+			/* <! Move assigns. Takes the blocks of other when the allocator propagates or compares equal,
+				otherwise moves the elements one by one into blocks of this list's allocator.
+			*/
+			unrolled_list & operator= ( unrolled_list && other ) noexcept( block_traits::propagate_on_container_move_assignment::value || block_traits::is_always_equal::value );
+			unrolled_list & operator= ( std::initializer_list<T> ilist );
+
+			allocator_type get_allocator() const { return allocator_type(m_alloc); }
+
+			//[II] ITERATORS
+			iterator begin(){ return iterator(m_sentinel.next, 0); }
+			const_iterator begin() const { return cbegin(); }
+			const_iterator cbegin() const { return const_iterator(m_sentinel.next, 0); }
+			iterator end(){ return iterator(&m_sentinel, 0); }
+			const_iterator end() const { return cend(); }
+			const_iterator cend() const { return const_iterator(const_cast<BlockBase*>(&m_sentinel), 0); }
+
+			//[III] CAPACITY
+			int size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+
+			/* <! Returns the number of blocks in use. */
+			int blocks() const { return m_blocks; }
+
+			//[IV] MODIFIERS
+			void clear();
+
+			T & front(){ return *slot(m_sentinel.next, 0); }
+			const T & front() const { return *slot(m_sentinel.next, 0); }
+			T & back(){ return *slot(m_sentinel.prev, m_sentinel.prev->count - 1); }
+			const T & back() const { return *slot(m_sentinel.prev, m_sentinel.prev->count - 1); }
+
+			void push_front( const T & value ){ emplace(cbegin(), value); }
+			void push_front( T && value ){ emplace(cbegin(), std::move(value)); }
+			void push_back( const T & value ){ emplace_back(value); }
+			void push_back( T && value ){ emplace_back(std::move(value)); }
+
+			template<typename... Args>
+			T & emplace_front( Args &&... args ){ return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+			/* <! Builds a value in place at the end; fills the last block before opening a new one. */
+			template<typename... Args>
+			T & emplace_back( Args &&... args );
+
+			void pop_front(){ erase(cbegin()); }
+			void pop_back(){ erase(const_iterator(m_sentinel.prev, m_sentinel.prev->count - 1)); }
+
+			/* <! Replaces every element with a copy of value. */
+			void assign( const T & value );
+
+			template<typename InItr>
+			void assign( InItr first, InItr last );
+
+			void assign( std::initializer_list<T> ilist ){ assign(ilist.begin(), ilist.end()); }
+
+			//[IV-a] MODIFIERS WITH ITERATORS
+
+			/* <! Builds a value in place before pos. Splits the block if it is full.
+				@return The iterator to the new value.
+			*/
+			template<typename... Args>
+			iterator emplace( const_iterator pos, Args &&... args );
+
+			iterator insert( const_iterator pos, const T & value ){ return emplace(pos, value); }
+			iterator insert( const_iterator pos, T && value ){ return emplace(pos, std::move(value)); }
+
+			/* <! Insert elements from the range [first; last) before pos.
+				@return The iterator to the first element added, or pos if the range is empty.
+			*/
+			template<typename InItr>
+			iterator insert( const_iterator pos, InItr first, InItr last );
+
+			iterator insert( const_iterator pos, std::initializer_list<T> ilist ){ return insert(pos, ilist.begin(), ilist.end()); }
+
+			/* <! Removes the object at pos. Merges the block with a neighbour when both get sparse.
+				@return Iterator to the element after pos.
+			*/
+			iterator erase( const_iterator pos );
+
+			/* <! Removes the objects on the range [first; last).
+				@return Iterator to the element that followed the range.
+			*/
+			iterator erase( const_iterator first, const_iterator last );
+
+			/* <! Search for a value in the list, one block array at a time.
+				@return The position of the value, or end() if it is not in the list.
+			*/
+			const_iterator find( const T & value ) const;
+
+			/* <! Returns the iterator count positions after first, skipping whole blocks. */
+			iterator next( iterator first, int count ){ return first + count; }
+
+			bool operator==( const unrolled_list & rhs ) const;
+			bool operator!=( const unrolled_list & rhs ) const { return !(*this == rhs); }
+
+		private:
+			/* <! Address of the element at index i of block b. */
+			static T * slot( BlockBase * b, int i ){
+				return std::launder( reinterpret_cast<T*>( static_cast<Block*>(b)->storage ) ) + i;
+			}
+
+			/* <! Allocates an empty block and links it between p and n. */
+			BlockBase * create_block( BlockBase * p, BlockBase * n );
+
+			/* <! Unlinks an empty block and frees it. */
+			void destroy_block( BlockBase * b );
+
+			/* <! Builds value at index i of block b, which has room, shifting the tail right. */
+			void place( BlockBase * b, int i, T && value );
+
+			/* <! Moves every element of b to the end of a and frees b. */
+			void absorb( BlockBase * a, BlockBase * b );
+
+			/* <! Takes the blocks of other, which is left empty. This list must be empty. */
+			void steal( unrolled_list & other ) noexcept;
+
+			block_allocator_type m_alloc;
+			int m_size = 0;
+			int m_blocks = 0;
+			BlockBase m_sentinel; //<! m_sentinel.next is the first block and m_sentinel.prev the last.
+	};
+
+	//=======================================================================================
+
+	//CONST_ITERATOR
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::const_iterator & unrolled_list<T,BlockBytes,Allocator>::const_iterator::operator++(){
+		if( ++index == block->count ){
+			block = block->next;
+			index = 0;
+		}
+		return *this;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::const_iterator unrolled_list<T,BlockBytes,Allocator>::const_iterator::operator++(int){
+		const_iterator temp(*this);
+		++(*this);
+		return temp;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::const_iterator & unrolled_list<T,BlockBytes,Allocator>::const_iterator::operator--(){
+		if( index == 0 ){
+			block = block->prev;
+			index = block->count;
+		}
+		index--;
+		return *this;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::const_iterator unrolled_list<T,BlockBytes,Allocator>::const_iterator::operator--(int){
+		const_iterator temp(*this);
+		--(*this);
+		return temp;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::const_iterator unrolled_list<T,BlockBytes,Allocator>::const_iterator::operator+(int add) const{
+		if( add < 0 ) return *this - (-add);
+
+		const_iterator temp(*this);
+		// Whole blocks are skipped by their count.
+		while( add > 0 && add >= temp.block->count - temp.index && temp.block->count != 0 ){
+			add -= temp.block->count - temp.index;
+			temp.block = temp.block->next;
+			temp.index = 0;
+		}
+		temp.index += add;
+		return temp;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::const_iterator unrolled_list<T,BlockBytes,Allocator>::const_iterator::operator-(int sub) const{
+		if( sub < 0 ) return *this + (-sub);
+
+		const_iterator temp(*this);
+		while( sub > temp.index ){
+			sub -= temp.index + 1;
+			temp.block = temp.block->prev;
+			temp.index = temp.block->count - 1;
+		}
+		temp.index -= sub;
+		return temp;
+	}
+
+	//=======================================================================================
+
+	//SPECIAL MEMBERS
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator>::unrolled_list( const Allocator & alloc ) : m_alloc(alloc){
+		m_sentinel.next = &m_sentinel;
+		m_sentinel.prev = &m_sentinel;
+		m_sentinel.count = 0;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	template<typename InputIt>
+	unrolled_list<T,BlockBytes,Allocator>::unrolled_list( InputIt first, InputIt last, const Allocator & alloc ) : unrolled_list(alloc){
+		for(; first != last; ++first){
+			emplace_back(*first);
+		}
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator>::unrolled_list( std::initializer_list<T> ilist, const Allocator & alloc ) :
+		unrolled_list(ilist.begin(), ilist.end(), alloc){ /*empty*/ }
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator>::unrolled_list( const unrolled_list & other ) :
+		unrolled_list(other.cbegin(), other.cend(), block_traits::select_on_container_copy_construction(other.m_alloc)){ /*empty*/ }
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator>::unrolled_list( unrolled_list && other ) noexcept : unrolled_list(Allocator(other.m_alloc)){
+		steal(other);
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator>::~unrolled_list(){
+		clear();
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator> & unrolled_list<T,BlockBytes,Allocator>::operator= ( const unrolled_list & other ){
+		if(this == &other) return *this;
+
+		clear();
+		if constexpr(block_traits::propagate_on_container_copy_assignment::value){
+			m_alloc = other.m_alloc;
+		}
+		for(auto i(other.cbegin()); i != other.cend(); ++i){
+			emplace_back(*i);
+		}
+		return *this;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator> & unrolled_list<T,BlockBytes,Allocator>::operator= ( unrolled_list && other )
+		noexcept( block_traits::propagate_on_container_move_assignment::value || block_traits::is_always_equal::value ){
+		if(this == &other) return *this;
+
+		if(block_traits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc){
+			clear();
+			if constexpr(block_traits::propagate_on_container_move_assignment::value){
+				m_alloc = other.m_alloc;
+			}
+			steal(other);
+		}else{
+			// Blocks cannot change hands between unrelated allocators.
+			clear();
+			for(auto i(other.begin()); i != other.end(); ++i){
+				emplace_back(std::move(*i));
+			}
+			other.clear();
+		}
+		return *this;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	unrolled_list<T,BlockBytes,Allocator> & unrolled_list<T,BlockBytes,Allocator>::operator= ( std::initializer_list<T> ilist ){
+		assign(ilist.begin(), ilist.end());
+		return *this;
+	}
+
+	//=======================================================================================
+
+	//BLOCKS
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::BlockBase * unrolled_list<T,BlockBytes,Allocator>::create_block( BlockBase * p, BlockBase * n ){
+		Block *temp = block_traits::allocate(m_alloc, 1);
+		temp->count = 0;
+		temp->prev = p;
+		temp->next = n;
+		p->next = temp;
+		n->prev = temp;
+		m_blocks++;
+		return temp;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	void unrolled_list<T,BlockBytes,Allocator>::destroy_block( BlockBase * b ){
+		b->prev->next = b->next;
+		b->next->prev = b->prev;
+		block_traits::deallocate(m_alloc, static_cast<Block*>(b), 1);
+		m_blocks--;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	void unrolled_list<T,BlockBytes,Allocator>::place( BlockBase * b, int i, T && value ){
+		T *d = slot(b, 0);
+
+		if( i == b->count ){
+			block_traits::construct(m_alloc, d + i, std::move(value));
+		}else{
+			block_traits::construct(m_alloc, d + b->count, std::move(d[b->count - 1]));
+			std::move_backward(d + i, d + b->count - 1, d + b->count);
+			d[i] = std::move(value);
+		}
+
+		b->count++;
+		m_size++;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	void unrolled_list<T,BlockBytes,Allocator>::absorb( BlockBase * a, BlockBase * b ){
+		T *from = slot(b, 0);
+		T *to = slot(a, a->count);
+
+		for( int i = 0; i < b->count; ++i ){
+			block_traits::construct(m_alloc, to + i, std::move(from[i]));
+			block_traits::destroy(m_alloc, from + i);
+		}
+
+		a->count += b->count;
+		b->count = 0;
+		destroy_block(b);
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	void unrolled_list<T,BlockBytes,Allocator>::steal( unrolled_list & other ) noexcept{
+		if(other.m_blocks == 0) return;
+
+		m_sentinel.next = other.m_sentinel.next;
+		m_sentinel.prev = other.m_sentinel.prev;
+		m_sentinel.next->prev = &m_sentinel;
+		m_sentinel.prev->next = &m_sentinel;
+		m_size = other.m_size;
+		m_blocks = other.m_blocks;
+
+		other.m_sentinel.next = &other.m_sentinel;
+		other.m_sentinel.prev = &other.m_sentinel;
+		other.m_size = 0;
+		other.m_blocks = 0;
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	void unrolled_list<T,BlockBytes,Allocator>::clear(){
+		BlockBase *b = m_sentinel.next;
+
+		while( b != &m_sentinel ){
+			BlockBase *next = b->next;
+			for( int i = 0; i < b->count; ++i ){
+				block_traits::destroy(m_alloc, slot(b, i));
+			}
+			block_traits::deallocate(m_alloc, static_cast<Block*>(b), 1);
+			b = next;
+		}
+
+		m_sentinel.next = &m_sentinel;
+		m_sentinel.prev = &m_sentinel;
+		m_size = 0;
+		m_blocks = 0;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	template<typename... Args>
+	T & unrolled_list<T,BlockBytes,Allocator>::emplace_back( Args &&... args ){
+		BlockBase *b = m_sentinel.prev;
+		bool opened = false;
+
+		if( b == &m_sentinel || b->count == capacity ){
+			b = create_block(m_sentinel.prev, &m_sentinel);
+			opened = true;
+		}
+
+		T *p = slot(b, b->count);
+		try{
+			block_traits::construct(m_alloc, p, std::forward<Args>(args)...);
+		}catch(...){
+			if(opened) destroy_block(b);
+			throw;
+		}
+
+		b->count++;
+		m_size++;
+		return *p;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	void unrolled_list<T,BlockBytes,Allocator>::assign( const T & value ){
+		for(auto i(begin()); i != end(); ++i){
+			*i = value;
+		}
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	template<typename InItr>
+	void unrolled_list<T,BlockBytes,Allocator>::assign( InItr first, InItr last ){
+		clear();
+		for(; first != last; ++first){
+			emplace_back(*first);
+		}
+	}
+
+	//=======================================================================================
+
+	//MODIFIERS WITH ITERATORS
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	template<typename... Args>
+	typename unrolled_list<T,BlockBytes,Allocator>::iterator unrolled_list<T,BlockBytes,Allocator>::emplace( const_iterator pos, Args &&... args ){
+		if( pos.block == &m_sentinel ){
+			emplace_back(std::forward<Args>(args)...);
+			return iterator(m_sentinel.prev, m_sentinel.prev->count - 1);
+		}
+
+		// Built first, so a throwing constructor leaves the blocks alone.
+		T value(std::forward<Args>(args)...);
+		BlockBase *b = pos.block;
+		int i = pos.index;
+
+		if( b->count < capacity ){
+			place(b, i, std::move(value));
+			return iterator(b, i);
+		}
+
+		// Full block: prefer the room at the end of the previous block.
+		if( i == 0 && b->prev != &m_sentinel && b->prev->count < capacity ){
+			b = b->prev;
+			place(b, b->count, std::move(value));
+			return iterator(b, b->count - 1);
+		}
+
+		if( i == 0 ){
+			b = create_block(b->prev, b);
+			place(b, 0, std::move(value));
+			return iterator(b, 0);
+		}
+
+		// Split: the upper half moves to a new block after b.
+		BlockBase *n = create_block(b, b->next);
+		int half = b->count / 2;
+		T *from = slot(b, half);
+		T *to = slot(n, 0);
+		for( int k = 0; k < b->count - half; ++k ){
+			block_traits::construct(m_alloc, to + k, std::move(from[k]));
+			block_traits::destroy(m_alloc, from + k);
+		}
+		n->count = b->count - half;
+		b->count = half;
+
+		if( i > half ){
+			b = n;
+			i -= half;
+		}
+		place(b, i, std::move(value));
+		return iterator(b, i);
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	template<typename InItr>
+	typename unrolled_list<T,BlockBytes,Allocator>::iterator unrolled_list<T,BlockBytes,Allocator>::insert( const_iterator pos, InItr first, InItr last ){
+		iterator temp(pos);
+		int size = 0;
+
+		// Each insertion may split a block, so always continue from the iterator it returns.
+		for(; first != last; ++first){
+			temp = emplace(temp, *first);
+			++temp;
+			size++;
+		}
+
+		return temp - size;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::iterator unrolled_list<T,BlockBytes,Allocator>::erase( const_iterator pos ){
+		if( pos.block == &m_sentinel ) return end();
+
+		BlockBase *b = pos.block;
+		int i = pos.index;
+		T *d = slot(b, 0);
+
+		std::move(d + i + 1, d + b->count, d + i);
+		block_traits::destroy(m_alloc, d + b->count - 1);
+		b->count--;
+		m_size--;
+
+		if( b->count == 0 ){
+			BlockBase *n = b->next;
+			destroy_block(b);
+			return iterator(n, 0);
+		}
+
+		// Keep the blocks at least half full on average.
+		if( b->next != &m_sentinel && b->count + b->next->count <= capacity / 2 ){
+			absorb(b, b->next);
+		}
+		if( b->prev != &m_sentinel && b->prev->count + b->count <= capacity / 2 ){
+			BlockBase *p = b->prev;
+			i += p->count;
+			absorb(p, b);
+			b = p;
+		}
+
+		return (i < b->count) ? iterator(b, i) : iterator(b->next, 0);
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::iterator unrolled_list<T,BlockBytes,Allocator>::erase( const_iterator first, const_iterator last ){
+		// Merges move elements around, so count first and erase from a fresh iterator each time.
+		int count = 0;
+		for(auto i(first); i != last; ++i){
+			count++;
+		}
+
+		iterator temp(first);
+		while( count-- > 0 ){
+			temp = erase(temp);
+		}
+		return temp;
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	typename unrolled_list<T,BlockBytes,Allocator>::const_iterator unrolled_list<T,BlockBytes,Allocator>::find( const T & value ) const{
+		for( BlockBase *b = m_sentinel.next; b != &m_sentinel; b = b->next ){
+			const T *d = slot(b, 0);
+			for( int i = 0; i < b->count; ++i ){
+				if( d[i] == value ) return const_iterator(b, i);
+			}
+		}
+
+		return cend();
+	}
+
+	template<typename T, std::size_t BlockBytes, typename Allocator>
+	bool unrolled_list<T,BlockBytes,Allocator>::operator==( const unrolled_list & rhs ) const{
+		if( m_size != rhs.m_size ) return false;
+
+		auto j(rhs.cbegin());
+		for( auto i(cbegin()); i != cend(); ++i, ++j ){
+			if( !(*i == *j) ) return false;
+		}
+		return true;
+	}
+}
+
+#endif
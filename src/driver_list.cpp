@@ -1,6 +1,104 @@
 #include <iostream>  // cout, endl
 #include <cassert>   // assert()
+#include <cstdlib>   // abort()
+#include <atomic>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 #include "../include/list.h"
+#include "../include/fingerprinted_list.h"
+#include "../include/unrolled_list.h"
+#include "../include/indexed_list.h"
+#include "../include/concurrent_list.h"
+#include "../include/lockfree_queue.h"
+#include "../include/list_parallel.h"
+#include "../include/indexed_find_list.h"
+#include "../include/lru_cache.h"
+#include "../include/intrusive_list.h"
+#include "../include/compact_list.h"
+#include "../include/list_io.h"
+#include "../include/cow_list.h"
+
+#define MOVE_SYNTAX_IMPLEMENTED
+
+// Throws when copied while armed.
+struct fragile
+{
+    static bool armed;
+    int value;
+
+    fragile( int v ) : value( v ) { /*empty*/ }
+    fragile( const fragile & other ) : value( other.value )
+    {
+        if ( armed and value < 0 ) throw value;
+    }
+};
+bool fragile::armed = false;
+
+// Has no default constructor.
+struct no_default
+{
+    int value;
+    explicit no_default( int v ) : value( v ) { /*empty*/ }
+};
+
+// Counts how many times it was copied.
+struct tracked
+{
+    static int copies;
+    int id;
+    std::string name;
+
+    tracked( int i = 0, std::string n = "" ) : id( i ), name( std::move( n ) ) { /*empty*/ }
+    tracked( const tracked & other ) : id( other.id ), name( other.name ) { ++copies; }
+    tracked( tracked && ) = default;
+    tracked & operator=( const tracked & ) = default;
+    tracked & operator=( tracked && ) = default;
+};
+int tracked::copies = 0;
+
+// Memory resource that keeps track of what goes through it.
+class counting_resource : public std::pmr::memory_resource
+{
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+
+    private:
+        void * do_allocate( size_t bytes, size_t align ) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate( bytes, align );
+        }
+        void do_deallocate( void * p, size_t bytes, size_t align ) override
+        {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate( p, bytes, align );
+        }
+        bool do_is_equal( const std::pmr::memory_resource & other ) const noexcept override
+        {
+            return this == &other;
+        }
+};
+
+// Destroyed at exit, after the pools of the main thread: its nodes go back to the depot,
+// and a list built this late still works.
+struct exit_check
+{
+    ls::list<int> seq;
+
+    ~exit_check()
+    {
+        seq.clear();
+        ls::list<int> late { 1, 2, 3 };
+        late.pop_front();
+        late.compact();
+        if ( late.size() != 2 or late.front() != 2 or late.fragmentation() != 1.0 ) std::abort();
+    }
+};
+static exit_check g_exit_check;
 
 template < typename T = int >
 ls::list<T> createVec( const ls::list<T> & _v )
@@ -518,5 +616,1512 @@ int main( void )
         std::cout << ">>> Passed!\n\n";
     }
 
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": node recycling.\n";
+
+        ls::list<int> seq { 1, 2, 3, 4, 5 };
+
+        // A node given back by pop_back() is the next one handed out.
+        const int * last = &seq.back();
+        seq.pop_back();
+        seq.push_back( 6 );
+        assert( &seq.back() == last );
+        assert( seq == ( ls::list<int>{ 1, 2, 3, 4, 6 } ) );
+
+        // Same for erase() and insert() in the middle.
+        auto it = seq.next( seq.begin(), 2 );
+        const int * middle = &*it;
+        it = seq.erase( it );
+        it = seq.insert( it, 7 );
+        assert( &*it == middle );
+        assert( seq == ( ls::list<int>{ 1, 2, 7, 4, 6 } ) );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": pmr allocator.\n";
+
+        counting_resource res;
+        {
+            ls::pmr::list<int> seq( { 1, 2, 3, 4, 5 }, &res );
+            assert( seq.get_allocator().resource() == &res );
+            // One node per element, the sentinel lives in the list itself.
+            assert( res.allocations == 5 );
+
+            seq.push_back( 6 );
+            seq.erase( seq.begin() );
+            seq = { 7, 8, 9 };
+            seq.insert( seq.end(), { 10, 11 } );
+            assert( res.allocations - res.deallocations == 5 );
+
+            // The copy keeps the resource only when asked to.
+            ls::pmr::list<int> copy( seq, &res );
+            assert( copy.get_allocator().resource() == &res );
+            assert( res.allocations - res.deallocations == 10 );
+
+            // Copy and move assignment keep each list on its own resource.
+            ls::pmr::list<int> other( &res );
+            other = copy;
+            assert( other == copy );
+            other = std::move( seq );
+            assert( other == ( ls::pmr::list<int>{ 7, 8, 9, 10, 11 } ) );
+            assert( seq.empty() );
+        }
+        assert( res.allocations == res.deallocations );
+
+        // A monotonic arena serves the whole list.
+        char buffer[ 1024 ];
+        std::pmr::monotonic_buffer_resource arena( buffer, sizeof( buffer ), std::pmr::null_memory_resource() );
+        ls::pmr::list<int> seq( { 1, 2, 3 }, &arena );
+        assert( (char*) &seq.back() >= buffer and (char*) &seq.back() < buffer + sizeof( buffer ) );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": emplace and rvalue insertion.\n";
+
+        ls::list<tracked> seq;
+        tracked::copies = 0;
+
+        seq.emplace_back( 2, "two" );
+        seq.emplace_front( 1, "one" );
+        auto it = seq.emplace( seq.end(), 4, "four" );
+        assert( it->data.id == 4 );
+        seq.insert( it, tracked( 3, "three" ) );
+        seq.push_back( tracked( 5, "five" ) );
+        seq.push_front( tracked( 0, "zero" ) );
+
+        std::string large( 1000, 'x' );
+        seq.push_back( tracked( 6, std::move( large ) ) );
+        assert( seq.back().name.size() == 1000 );
+        assert( tracked::copies == 0 );
+
+        auto i{0};
+        for ( const auto & e : seq )
+            assert( e.id == i++ );
+        assert( seq.size() == 7 );
+
+        // Moving the whole list does not touch the elements.
+        ls::list<tracked> seq2( std::move( seq ) );
+        seq = std::move( seq2 );
+        assert( tracked::copies == 0 );
+        assert( seq.size() == 7 and seq2.empty() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": allocation-free empty lists.\n";
+
+        counting_resource res;
+        {
+            ls::pmr::list<int> seq( &res );
+            assert( seq.empty() and seq.begin() == seq.end() );
+            ls::pmr::list<int> seq2( std::move( seq ) );
+            seq = std::move( seq2 );
+            seq.clear();
+            assert( seq.find( 0 ) == seq.cend() );
+        }
+        assert( res.allocations == 0 );
+
+        // Moving a list keeps its nodes but re-targets them at the new sentinel.
+        ls::list<int> seq { 1, 2, 3 };
+        const int * first = &seq.front();
+        ls::list<int> seq2( std::move( seq ) );
+        assert( &seq2.front() == first );
+        seq2.push_back( 4 );
+        seq2.push_front( 0 );
+        assert( seq2 == ( ls::list<int>{ 0, 1, 2, 3, 4 } ) );
+        assert( seq.empty() );
+        seq.push_back( 5 );
+        assert( seq == ( ls::list<int>{ 5 } ) );
+
+        // T need not be default constructible.
+        ls::list<no_default> nd;
+        nd.emplace_back( 1 );
+        nd.push_front( no_default( 0 ) );
+        assert( nd.front().value == 0 and nd.back().value == 1 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": splice() and split_at().\n";
+
+        ls::list<int> seq { 1, 2, 3 };
+        ls::list<int> other { 4, 5, 6 };
+        const int * four = &other.front();
+
+        // Concatenate: the nodes themselves change hands.
+        seq.splice( seq.end(), other );
+        assert( seq == ( ls::list<int>{ 1, 2, 3, 4, 5, 6 } ) );
+        assert( other.empty() and other.size() == 0 );
+        assert( &*seq.next( seq.begin(), 3 ) == four );
+
+        // Single element, from another list and within the same list.
+        other = { 7, 8 };
+        seq.splice( seq.begin(), other, other.next( other.begin(), 1 ) );
+        assert( seq == ( ls::list<int>{ 8, 1, 2, 3, 4, 5, 6 } ) );
+        assert( other == ( ls::list<int>{ 7 } ) );
+        seq.splice( seq.end(), seq, seq.begin() );
+        assert( seq == ( ls::list<int>{ 1, 2, 3, 4, 5, 6, 8 } ) );
+        assert( seq.size() == 7 );
+
+        // A range.
+        other.splice( other.end(), seq, seq.next( seq.begin(), 1 ), seq.next( seq.begin(), 4 ) );
+        assert( seq == ( ls::list<int>{ 1, 5, 6, 8 } ) );
+        assert( other == ( ls::list<int>{ 7, 2, 3, 4 } ) );
+        assert( seq.size() == 4 and other.size() == 4 );
+
+        // Split near the front, near the back, and at both ends.
+        seq = { 1, 2, 3, 4, 5, 6 };
+        auto tail = seq.split_at( seq.next( seq.begin(), 1 ) );
+        assert( seq == ( ls::list<int>{ 1 } ) and seq.size() == 1 );
+        assert( tail == ( ls::list<int>{ 2, 3, 4, 5, 6 } ) and tail.size() == 5 );
+        auto last = tail.split_at( tail.next( tail.begin(), 4 ) );
+        assert( tail.size() == 4 and last == ( ls::list<int>{ 6 } ) and last.size() == 1 );
+        auto none = tail.split_at( tail.end() );
+        assert( none.empty() and tail.size() == 4 );
+        auto all = tail.split_at( tail.begin() );
+        assert( tail.empty() and all.size() == 4 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": merge(), sort() and reverse().\n";
+
+        ls::list<int> seq { 5, 3, 9, 1, 7, 3, 8, 2, 6, 4, 0 };
+        const int * nine = &*seq.next( seq.begin(), 2 );
+        seq.sort();
+        assert( seq == ( ls::list<int>{ 0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9 } ) );
+        assert( &seq.back() == nine );
+
+        // Walk backwards too, so the prev links are checked.
+        auto it = seq.end();
+        auto previous{10};
+        while ( it != seq.begin() )
+        {
+            --it;
+            assert( *it <= previous );
+            previous = *it;
+        }
+
+        seq.sort( []( int a, int b ){ return a > b; } );
+        assert( seq == ( ls::list<int>{ 9, 8, 7, 6, 5, 4, 3, 3, 2, 1, 0 } ) );
+
+        // Stable: equal keys keep their order.
+        ls::list<tracked> people;
+        people.emplace_back( 1, "b" );
+        people.emplace_back( 0, "a" );
+        people.emplace_back( 1, "c" );
+        people.emplace_back( 0, "d" );
+        tracked::copies = 0;
+        people.sort( []( const tracked & a, const tracked & b ){ return a.id < b.id; } );
+        std::string order;
+        for ( const auto & p : people )
+            order += p.name;
+        assert( order == "adbc" );
+        assert( tracked::copies == 0 );
+
+        ls::list<int> a { 1, 4, 6, 9 };
+        ls::list<int> b { 0, 4, 5, 10, 11 };
+        a.merge( b );
+        assert( a == ( ls::list<int>{ 0, 1, 4, 4, 5, 6, 9, 10, 11 } ) );
+        assert( a.size() == 9 and b.empty() );
+        b.merge( a );
+        assert( b.size() == 9 and a.empty() );
+
+        b.reverse();
+        assert( b == ( ls::list<int>{ 11, 10, 9, 6, 5, 4, 4, 1, 0 } ) );
+        b.push_back( -1 );
+        b.push_front( 12 );
+        assert( b.front() == 12 and b.back() == -1 );
+        a.reverse();
+        assert( a.empty() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": operator<() and friends.\n";
+
+        ls::list<int> seq { 1, 2, 3 };
+        assert( seq < ( ls::list<int>{ 1, 2, 4 } ) );
+        assert( seq < ( ls::list<int>{ 1, 2, 3, 0 } ) );
+        assert( not ( seq < seq ) and seq <= seq and seq >= seq );
+        assert( seq > ( ls::list<int>{ 1, 2 } ) );
+        assert( seq > ( ls::list<int>{} ) );
+        assert( ( ls::list<int>{} ) < seq );
+        assert( ( ls::list<int>{ 0, 9 } ) <= seq );
+
+        // Equality on a long list is a single pass.
+        ls::list<int> big, big2;
+        for ( int i = 0 ; i < 200000 ; ++i )
+        {
+            big.push_back( i );
+            big2.push_back( i );
+        }
+        assert( big == big2 );
+        big2.back() = -1;
+        assert( big != big2 and big2 < big );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": fingerprinted_list.\n";
+
+        ls::fingerprinted_list<int> seq { 1, 2, 3 };
+        ls::fingerprinted_list<int> seq2;
+        assert( seq2.fingerprint() == 0 );
+
+        // The fingerprint follows the contents, however they were built.
+        seq2.push_back( 3 );
+        seq2.push_front( 1 );
+        seq2.insert( seq2.find( 3 ), 2 );
+        assert( seq2.fingerprint() == seq.fingerprint() );
+        assert( seq == seq2 );
+
+        seq2.pop_back();
+        assert( seq2.fingerprint() != seq.fingerprint() and seq != seq2 );
+        seq2.emplace_back( 3 );
+        assert( seq == seq2 );
+
+        // Same elements, other order: same fingerprint, still unequal.
+        ls::fingerprinted_list<int> rev { 3, 2, 1 };
+        assert( rev.fingerprint() == seq.fingerprint() );
+        assert( rev != seq and seq < rev );
+
+        // erase and splice keep it in step.
+        ls::fingerprinted_list<int> tail { 4, 5 };
+        seq.splice( seq.end(), tail );
+        assert( tail.fingerprint() == 0 and tail.empty() );
+        assert( seq == ( ls::fingerprinted_list<int>{ 1, 2, 3, 4, 5 } ) );
+        seq.erase( seq.find( 2 ), seq.find( 4 ) );
+        assert( seq == ( ls::fingerprinted_list<int>{ 1, 4, 5 } ) );
+        assert( seq.fingerprint() == ls::fingerprinted_list<int>( { 5, 4, 1 } ).fingerprint() );
+
+        ls::fingerprinted_list<int> moved( std::move( seq ) );
+        assert( seq.fingerprint() == 0 and seq.empty() );
+        moved.clear();
+        assert( moved.fingerprint() == 0 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": bulk insert(pos, first, last) and erase(first, last).\n";
+
+        ls::list<int> seq { 1, 2, 3 };
+        ls::list<int> source { 7, 8, 9 };
+
+        // The returned iterator points at the first new element.
+        auto it = seq.insert( seq.next( seq.begin(), 1 ), source.begin(), source.end() );
+        assert( *it == 7 );
+        assert( seq == ( ls::list<int>{ 1, 7, 8, 9, 2, 3 } ) and seq.size() == 6 );
+        assert( *( --it ) == 1 );
+
+        // An empty range inserts nothing and returns pos.
+        it = seq.insert( seq.end(), source.end(), source.end() );
+        assert( it == seq.end() and seq.size() == 6 );
+
+        // Erase returns last, and the links around the hole are consistent.
+        it = seq.erase( seq.next( seq.begin(), 1 ), seq.next( seq.begin(), 4 ) );
+        assert( *it == 2 and *( --it ) == 1 );
+        assert( seq == ( ls::list<int>{ 1, 2, 3 } ) and seq.size() == 3 );
+        it = seq.erase( seq.begin(), seq.begin() );
+        assert( it == seq.begin() and seq.size() == 3 );
+
+        // A throwing element leaves the list as it was.
+        ls::list<fragile> fr;
+        fr.emplace_back( 1 );
+        fr.emplace_back( 2 );
+        fragile items[] = { 3, 4, -1, 5 };
+        fragile::armed = true;
+        bool thrown = false;
+        try
+        {
+            fr.insert( fr.end(), items, items + 4 );
+        }
+        catch ( int )
+        {
+            thrown = true;
+        }
+        fragile::armed = false;
+        assert( thrown );
+        assert( fr.size() == 2 and fr.front().value == 1 and fr.back().value == 2 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": unrolled_list.\n";
+
+        // Four ints per block, so splits and merges happen early.
+        typedef ls::unrolled_list< int, 40 > small_list;
+        assert( small_list::capacity == 4 );
+
+        small_list seq;
+        for ( int i = 0 ; i < 10 ; ++i )
+            seq.push_back( i );
+        assert( seq.size() == 10 and seq.blocks() == 3 );
+        assert( seq.front() == 0 and seq.back() == 9 );
+
+        // A full block splits in two.
+        auto it = seq.insert( seq.begin() + 2, 100 );
+        assert( *it == 100 and *( it - 1 ) == 1 and *( it + 1 ) == 2 );
+        assert( seq == ( small_list{ 0, 1, 100, 2, 3, 4, 5, 6, 7, 8, 9 } ) and seq.blocks() == 4 );
+
+        // Walking backwards crosses the blocks too.
+        int steps = 0;
+        for ( auto i( seq.end() ) ; i != seq.begin() ; --i )
+            ++steps;
+        assert( steps == seq.size() and *( seq.end() - 3 ) == 7 and *( seq.end() - 11 ) == 0 );
+
+        seq.push_front( -1 );
+        assert( seq.front() == -1 and *seq.find( 100 ) == 100 and seq.find( 42 ) == seq.cend() );
+
+        // Sparse neighbours merge back.
+        it = seq.erase( seq.find( 0 ), seq.find( 7 ) );
+        assert( *it == 7 );
+        assert( seq == ( small_list{ -1, 7, 8, 9 } ) and seq.blocks() <= 2 );
+
+        seq.insert( seq.end(), { 10, 11, 12 } );
+        seq.pop_front();
+        seq.pop_back();
+        assert( seq == ( small_list{ 7, 8, 9, 10, 11 } ) and seq.size() == 5 );
+
+        small_list copy( seq );
+        small_list moved( std::move( seq ) );
+        assert( seq.empty() and seq.blocks() == 0 and copy == moved );
+        while ( not moved.empty() )
+            moved.erase( moved.begin() );
+        assert( moved.blocks() == 0 and moved != copy );
+
+        ls::unrolled_list< std::string > words { "a", "b" };
+        words.emplace( words.begin() + 1, 3, 'x' );
+        assert( *( words.begin() + 1 ) == "xxx" and words.size() == 3 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": indexed_list positional access.\n";
+
+        ls::indexed_list<int> seq;
+        for ( int i = 0 ; i < 1000 ; ++i )
+            seq.push_back( i );
+
+        for ( int i = 0 ; i < 1000 ; i += 37 )
+        {
+            assert( seq.at( i ) == i and *seq.iterator_at( i ) == i );
+            assert( seq.index_of( seq.iterator_at( i ) ) == i );
+        }
+        assert( seq.iterator_at( 1000 ) == seq.end() and seq.index_of( seq.end() ) == 1000 );
+        assert( *seq.next( seq.begin(), 500 ) == 500 );
+
+        // Mixed edits keep indices, iteration and the counts in step with a plain array.
+        int mirror[ 1000 ];
+        for ( int i = 0 ; i < 1000 ; ++i )
+            mirror[ i ] = i;
+        int size = 1000;
+        unsigned seed = 7;
+        for ( int round = 0 ; round < 2000 ; ++round )
+        {
+            seed = seed * 1103515245u + 12345u;
+            int i = int( ( seed >> 8 ) % unsigned( size ) );
+            if ( round % 2 == 0 )
+            {
+                auto it = seq.erase_at( i );
+                assert( seq.index_of( it ) == i );
+                for ( int k = i ; k + 1 < size ; ++k )
+                    mirror[ k ] = mirror[ k + 1 ];
+                --size;
+            }
+            else
+            {
+                auto it = seq.insert_at( i, -round );
+                assert( *it == -round and seq.index_of( it ) == i );
+                for ( int k = size ; k > i ; --k )
+                    mirror[ k ] = mirror[ k - 1 ];
+                mirror[ i ] = -round;
+                ++size;
+            }
+        }
+        assert( seq.size() == size );
+        int k = 0;
+        for ( auto it( seq.begin() ) ; it != seq.end() ; ++it, ++k )
+            assert( *it == mirror[ k ] and seq.at( k ) == mirror[ k ] );
+
+        // Insert and erase by iterator.
+        auto it = seq.insert( seq.iterator_at( 10 ), 4242 );
+        assert( seq.index_of( it ) == 10 and seq.at( 11 ) == mirror[ 10 ] );
+        it = seq.erase( seq.find( 4242 ) );
+        assert( seq.index_of( it ) == 10 and *it == mirror[ 10 ] );
+
+        bool thrown = false;
+        try
+        {
+            seq.at( seq.size() );
+        }
+        catch ( const std::out_of_range & )
+        {
+            thrown = true;
+        }
+        assert( thrown );
+
+        ls::indexed_list<int> copy( seq );
+        ls::indexed_list<int> moved( std::move( seq ) );
+        assert( seq.empty() and copy == moved and moved.at( 0 ) == mirror[ 0 ] );
+        moved.erase( moved.begin(), moved.iterator_at( 5 ) );
+        assert( moved.size() == size - 5 and moved.at( 0 ) == mirror[ 5 ] );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": advance_to() and the position finger.\n";
+
+        ls::list<int> seq;
+        for ( int i = 0 ; i < 100 ; ++i )
+            seq.push_back( i );
+
+        // Forward and backward scans, from the head, the tail and the finger.
+        for ( int i = 0 ; i < 100 ; ++i )
+            assert( *seq.advance_to( i ) == i );
+        for ( int i = 99 ; i >= 0 ; --i )
+            assert( *seq.advance_to( i ) == i );
+        assert( *seq.advance_to( 98 ) == 98 and *seq.advance_to( 1 ) == 1 );
+        assert( seq.advance_to( 100 ) == seq.end() );
+
+        // next() from the head or from the finger takes the short way.
+        assert( *seq.next( seq.begin(), 90 ) == 90 );
+        assert( *seq.next( seq.advance_to( 40 ), 2 ) == 42 );
+
+        // Edits that shift indices drop the finger.
+        seq.advance_to( 50 );
+        seq.push_front( -1 );
+        assert( *seq.advance_to( 50 ) == 49 );
+        seq.erase( seq.begin() );
+        assert( *seq.advance_to( 50 ) == 50 );
+        seq.reverse();
+        assert( *seq.advance_to( 50 ) == 49 );
+        ls::list<int> tail = seq.split_at( seq.advance_to( 60 ) );
+        assert( seq.size() == 60 and *seq.advance_to( 59 ) == 40 );
+        seq.splice( seq.begin(), tail );
+        assert( *seq.advance_to( 0 ) == 39 and *seq.advance_to( 40 ) == 99 );
+        seq.sort();
+        assert( *seq.advance_to( 40 ) == 40 );
+        seq.clear();
+        assert( seq.advance_to( 0 ) == seq.end() );
+
+        const ls::list<int> fixed { 5, 6, 7 };
+        assert( *fixed.advance_to( 2 ) == 7 and *fixed.advance_to( 1 ) == 6 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": concurrent_list.\n";
+
+        ls::concurrent_list<int> seq;
+        for ( int i = 1 ; i <= 5 ; ++i )
+            seq.push_back( i );
+        seq.push_front( 0 );
+        assert( seq.size() == 6 and *seq.begin() == 0 );
+
+        auto three = seq.find( 3 );
+        auto it = seq.insert_after( three, 30 );
+        assert( *it == 30 and seq.size() == 7 );
+
+        // An iterator parked on an erased node still steps forward.
+        assert( seq.erase( three ) and not seq.erase( three ) );
+        assert( *three == 3 and *( ++three ) == 30 );
+        assert( seq.insert_after( seq.find( 42 ), 1 ) == seq.end() );
+
+        assert( *seq.pop_front() == 0 and *seq.pop_back() == 5 );
+        int expected[] = { 1, 2, 30, 4 };
+        int k = 0;
+        seq.for_each( [&]( const int & v ) { assert( v == expected[ k++ ] ); } );
+        assert( k == 4 and seq.size() == 4 );
+        seq.clear();
+        assert( seq.empty() and not seq.pop_back() and seq.begin() == seq.end() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": concurrent_list under contention.\n";
+
+        const int n_threads = 8;
+        const int n_ops = 20000;
+        ls::concurrent_list<int> seq;
+        std::atomic<int> pushed { 0 }, removed { 0 };
+        std::atomic<bool> done { false };
+
+        std::vector<std::thread> workers;
+        for ( int t = 0 ; t < n_threads ; ++t )
+        {
+            workers.emplace_back( [&, t]
+            {
+                for ( int i = 0 ; i < n_ops ; ++i )
+                {
+                    int value = t * n_ops + i;
+                    switch ( i % 6 )
+                    {
+                        case 0: seq.push_back( value ); ++pushed; break;
+                        case 1: seq.push_front( value ); ++pushed; break;
+                        case 2: if ( seq.pop_front() ) ++removed; break;
+                        case 3:
+                        {
+                            auto it = seq.begin();
+                            if ( it != seq.end() and seq.insert_after( it, value ) != seq.end() )
+                                ++pushed;
+                            break;
+                        }
+                        case 4:
+                        {
+                            auto it = seq.begin();
+                            if ( it != seq.end() ) ++it;
+                            if ( it != seq.end() and seq.erase( it ) )
+                                ++removed;
+                            break;
+                        }
+                        default: if ( seq.pop_back() ) ++removed; break;
+                    }
+                }
+            } );
+        }
+
+        // Readers walk the list while it changes under them.
+        std::thread reader( [&]
+        {
+            while ( not done )
+            {
+                int count = 0;
+                for ( auto it = seq.begin() ; it != seq.end() ; ++it )
+                    if ( *it >= 0 ) ++count;
+                assert( count >= 0 );
+            }
+        } );
+
+        for ( auto & w : workers )
+            w.join();
+        done = true;
+        reader.join();
+
+        int count = 0;
+        for ( auto it = seq.begin() ; it != seq.end() ; ++it )
+            ++count;
+        assert( seq.size() == pushed - removed and count == seq.size() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": spsc_queue and mpsc_queue.\n";
+
+        // Consumed nodes go back to the producer: the steady state allocates nothing.
+        counting_resource counter;
+        {
+            ls::spsc_queue< int, std::pmr::polymorphic_allocator<int> > queue( &counter );
+            assert( queue.empty() and not queue.try_pop() );
+            for ( int round = 0 ; round < 1000 ; ++round )
+            {
+                queue.push( round );
+                queue.push( -round );
+                assert( *queue.try_pop() == round and *queue.try_pop() == -round );
+            }
+            assert( queue.empty() and counter.allocations <= 3 );
+            queue.emplace( 7 );
+        }
+        assert( counter.allocations == counter.deallocations );
+
+        const int n_items = 100000;
+        ls::spsc_queue< std::string > strings;
+        std::thread producer( [&]
+        {
+            for ( int i = 0 ; i < n_items ; ++i )
+                strings.emplace( std::to_string( i ) );
+        } );
+        for ( int i = 0 ; i < n_items ; )
+        {
+            if ( auto value = strings.try_pop() )
+                assert( *value == std::to_string( i++ ) );
+        }
+        producer.join();
+        assert( strings.empty() );
+
+        // Every producer's values come out in the order it pushed them.
+        const int n_producers = 4;
+        const int n_each = 20000;
+        ls::mpsc_queue<int> queue;
+        std::vector<std::thread> producers;
+        for ( int t = 0 ; t < n_producers ; ++t )
+            producers.emplace_back( [&, t]
+            {
+                for ( int i = 0 ; i < n_each ; ++i )
+                    queue.push( t * n_each + i );
+            } );
+
+        int last[ n_producers ] = { -1, -1, -1, -1 };
+        for ( int received = 0 ; received < n_producers * n_each ; )
+        {
+            if ( auto value = queue.try_pop() )
+            {
+                int t = *value / n_each;
+                assert( *value % n_each == last[ t ] + 1 );
+                last[ t ] = *value % n_each;
+                ++received;
+            }
+        }
+        for ( auto & p : producers )
+            p.join();
+        assert( queue.empty() and not queue.try_pop() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": ls::parallel algorithms.\n";
+
+        ls::parallel::thread_pool pool( 3 );
+        ls::list<long long> seq;
+        const int n = 100000;
+        for ( int i = 0 ; i < n ; ++i )
+            seq.push_back( i );
+
+        ls::parallel::for_each( pool, seq, []( long long & x ) { x += 1; } );
+        ls::parallel::transform_inplace( pool, seq, []( long long x ) { return 2 * x; } );
+        assert( seq.front() == 2 and seq.back() == 2LL * n );
+
+        long long sum = ls::parallel::reduce( pool, seq, 0LL, std::plus<long long>() );
+        assert( sum == 1LL * n * ( n + 1 ) );
+        assert( ls::parallel::reduce( seq, 0LL ) == sum );
+        assert( ls::parallel::count_if( pool, seq, []( long long x ) { return x % 4 == 0; } ) == n / 2 );
+
+        // Chunks are combined in order, so a non-commutative op works.
+        ls::list<std::string> letters;
+        std::string expected;
+        for ( int i = 0 ; i < 20000 ; ++i )
+        {
+            letters.push_back( std::string( 1, char( 'a' + i % 26 ) ) );
+            expected += letters.back();
+        }
+        assert( ls::parallel::reduce( pool, letters, std::string(), std::plus<std::string>() ) == expected );
+
+        // Empty lists and exceptions.
+        ls::list<long long> none;
+        assert( ls::parallel::reduce( pool, none, 5LL, std::plus<long long>() ) == 5 );
+        assert( ls::parallel::count_if( none, []( long long ) { return true; } ) == 0 );
+        bool thrown = false;
+        try
+        {
+            ls::parallel::for_each( pool, seq, []( long long & x ) { if ( x == 2LL * n ) throw 1; } );
+        }
+        catch ( int )
+        {
+            thrown = true;
+        }
+        assert( thrown );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": parallel::sort().\n";
+
+        ls::parallel::thread_pool pool( 3 );
+        ls::list<tracked> seq;
+        const int n = 50000;
+        unsigned seed = 11;
+        for ( int i = 0 ; i < n ; ++i )
+        {
+            seed = seed * 1103515245u + 12345u;
+            seq.emplace_back( int( ( seed >> 8 ) % 1000 ) * n + i );
+        }
+
+        // Sorted by the key only: equal keys must keep their insertion order.
+        int copies = tracked::copies;
+        const tracked * first = &seq.front();
+        ls::parallel::sort( pool, seq, []( const tracked & a, const tracked & b ) { return a.id / n < b.id / n; } );
+        assert( tracked::copies == copies and seq.size() == n );
+
+        int count = 0;
+        bool moved = false;
+        for ( auto it = seq.begin() ; it != seq.end() ; ++it, ++count )
+        {
+            moved = moved or &*it == first;
+            auto next = it;
+            if ( ++next != seq.end() )
+                assert( it->data.id < next->data.id );
+        }
+        assert( count == n and moved );
+        for ( auto it = seq.end() ; it != seq.begin() ; --it )
+            --count;
+        assert( count == 0 );
+
+        // Short lists fall back to sort().
+        ls::list<int> small { 3, 1, 2 };
+        ls::parallel::sort( small );
+        assert( small == ( ls::list<int>{ 1, 2, 3 } ) );
+        ls::parallel::sort( small, std::greater<int>() );
+        assert( small == ( ls::list<int>{ 3, 2, 1 } ) );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": indexed_find_list.\n";
+
+        ls::indexed_find_list<int> seq { 1, 2, 3, 2, 5 };
+        assert( seq.contains( 3 ) and not seq.contains( 4 ) and seq.count( 2 ) == 2 );
+        assert( *seq.find( 5 ) == 5 and seq.find( 7 ) == seq.end() );
+
+        // Iterators stay valid across the other edits.
+        auto three = seq.find( 3 );
+        seq.push_front( 0 );
+        seq.push_back( 6 );
+        seq.insert( three, 9 );
+        assert( seq.erase( 2 ) == 2 and not seq.contains( 2 ) and seq.erase( 2 ) == 0 );
+        assert( *three == 3 and *( --three ) == 9 );
+        assert( seq.items() == ( ls::list<int>{ 0, 1, 9, 3, 5, 6 } ) );
+
+        auto it = seq.erase( seq.find( 9 ) );
+        assert( *it == 3 and not seq.contains( 9 ) );
+        seq.pop_front();
+        seq.pop_back();
+        assert( not seq.contains( 0 ) and not seq.contains( 6 ) and seq.size() == 3 );
+
+        // The copy indexes its own nodes.
+        ls::indexed_find_list<int> copy( seq );
+        seq.erase( seq.begin(), seq.end() );
+        assert( seq.empty() and not seq.contains( 1 ) );
+        assert( copy.contains( 1 ) and copy.erase( 1 ) == 1 and copy.size() == 2 );
+        ls::indexed_find_list<int> moved( std::move( copy ) );
+        assert( *moved.find( 5 ) == 5 and moved.erase( 5 ) == 1 and moved.items() == ( ls::list<int>{ 3 } ) );
+
+        // With a key extractor.
+        struct by_id { int operator()( const tracked & t ) const { return t.id; } };
+        ls::indexed_find_list< tracked, by_id > people;
+        people.emplace_back( 7, "ada" );
+        people.emplace_back( 8, "bob" );
+        assert( people.find( 8 )->data.name == "bob" and people.erase( 7 ) == 1 and people.size() == 1 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": lru_cache.\n";
+
+        ls::lru_cache< int, std::string > cache( 3 );
+        cache.put( 1, "one" );
+        cache.put( 2, "two" );
+        cache.put( 3, "three" );
+        assert( *cache.get( 1 ) == "one" );
+
+        // 2 is now the least recently used entry.
+        cache.put( 4, "four" );
+        assert( not cache.contains( 2 ) and cache.get( 2 ) == nullptr and cache.size() == 3 );
+        assert( cache.stats().hits == 1 and cache.stats().misses == 1 and cache.stats().evictions == 1 );
+        assert( cache.begin()->data.first == 4 and ( --cache.end() )->data.first == 3 );
+
+        // Replacing a value promotes it; peek does not.
+        cache.put( 3, "THREE" );
+        assert( *cache.peek( 1 ) == "one" and cache.begin()->data.first == 3 );
+        cache.put( 5, "five" );
+        assert( not cache.contains( 1 ) and *cache.get( 3 ) == "THREE" );
+
+        assert( cache.erase( 4 ) and not cache.erase( 4 ) and cache.size() == 2 );
+        cache.set_capacity( 1 );
+        assert( cache.size() == 1 and cache.contains( 3 ) and cache.stats().evictions == 3 );
+        cache.reset_stats();
+        cache.clear();
+        assert( cache.empty() and cache.weight() == 0 and cache.stats().hits == 0 );
+
+        // Capacity in bytes, weighing the characters of the strings too.
+        struct string_bytes
+        {
+            size_t operator()( const int &, const std::string & s ) const { return sizeof( int ) + s.size(); }
+        };
+        ls::lru_cache< int, std::string, string_bytes > sized( 32 );
+        sized.put( 1, std::string( 20, 'a' ) );
+        sized.put( 2, std::string( 4, 'b' ) );
+        assert( sized.weight() == 32 and sized.size() == 2 );
+        sized.put( 3, "c" );
+        assert( not sized.contains( 1 ) and sized.weight() == 13 );
+        sized.put( 4, std::string( 100, 'd' ) );
+        assert( not sized.contains( 4 ) and sized.weight() <= 32 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": intrusive_list.\n";
+
+        struct Task
+        {
+            int id;
+            ls::list_hook ready; // One hook per list the object can be in.
+            ls::list_hook all;
+        };
+        typedef ls::intrusive_list< Task, &Task::ready > ready_list;
+        typedef ls::intrusive_list< Task, &Task::all > all_list;
+
+        Task t[5];
+        ready_list ready;
+        all_list all;
+        for ( int i = 0; i < 5; ++i )
+        {
+            t[i].id = i;
+            assert( not t[i].ready.is_linked() );
+            all.push_back( t[i] );
+        }
+        ready.push_back( t[1] );
+        ready.push_front( t[3] );
+        ready.insert( ready.iterator_to( t[1] ), t[4] );
+        assert( ready.size() == 3 and all.size() == 5 );
+        assert( ready.front().id == 3 and ready.back().id == 1 and ( ++ready.begin() )->id == 4 );
+        assert( &*ready.begin() == &t[3] );
+
+        // Unlinked from one list in O(1) from the object alone; the other list is untouched.
+        ready.erase( t[4] );
+        assert( not t[4].ready.is_linked() and t[4].all.is_linked() and ready.size() == 2 );
+        int sum = 0;
+        for ( auto i = all.begin(); i != all.end(); ++i ) sum += i->id;
+        assert( sum == 10 );
+        assert( ( --all.end() )->id == 4 );
+
+        // Splices relink the same objects.
+        ready_list other;
+        other.push_back( t[0] );
+        other.push_back( t[2] );
+        ready.splice( ready.cbegin(), other, ++other.cbegin() );
+        assert( ready.front().id == 2 and other.size() == 1 and ready.size() == 3 );
+        ready.splice( ready.cend(), other );
+        assert( other.empty() and ready.back().id == 0 and ready.size() == 4 );
+        other.splice( other.cend(), ready, ++ready.cbegin(), ready.cend() );
+        assert( ready.size() == 1 and other.size() == 3 and other.front().id == 3 );
+
+        ready_list moved( std::move( other ) );
+        assert( other.empty() and moved.size() == 3 );
+        moved.pop_front();
+        moved.pop_back();
+        assert( moved.size() == 1 and moved.front().id == 1 and not t[3].ready.is_linked() );
+
+        all.erase( ++all.cbegin(), --all.cend() );
+        assert( all.size() == 2 and all.front().id == 0 and all.back().id == 4 );
+        moved.clear();
+        assert( moved.empty() and not t[1].ready.is_linked() );
+
+        // Objects that are not standard layout, with the hook after other members.
+        struct Job
+        {
+            virtual ~Job() = default;
+            std::string name;
+            ls::list_hook link;
+        };
+        Job jobs[2];
+        jobs[0].name = "first";
+        jobs[1].name = "second";
+        ls::intrusive_list< Job, &Job::link > queue;
+        queue.push_back( jobs[0] );
+        queue.push_back( jobs[1] );
+        assert( &queue.front() == &jobs[0] and queue.back().name == "second" );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": compact_list.\n";
+
+        ls::compact_list<int> seq;
+        assert( seq.empty() and seq.capacity() == 0 and seq.begin() == seq.end() );
+
+        for ( int i = 0; i < 100; ++i ) seq.push_back( i );
+        auto h = seq.handle_of( seq.find( 42 ) );
+        seq.push_front( -1 );
+        seq.insert( seq.iterator_to( h ), 1000 );
+        assert( seq.size() == 102 and seq.front() == -1 and seq.back() == 99 );
+        assert( seq[ h ] == 42 and *--seq.iterator_to( h ) == 1000 );
+
+        // Erased slots are reused before the array grows again.
+        int cap = seq.capacity();
+        for ( int i = 0; i < 10; ++i ) seq.pop_back();
+        for ( int i = 0; i < 10; ++i ) seq.push_back( i );
+        assert( seq.capacity() == cap and seq.size() == 102 and seq[ h ] == 42 );
+
+        // Copies keep every index, so handles carry over.
+        ls::compact_list<int> copy( seq );
+        assert( copy == seq and copy[ h ] == 42 );
+        copy[ h ] = 7;
+        assert( seq[ h ] == 42 and copy != seq );
+
+        ls::compact_list<int> small { 1, 2, 3, 4, 5 };
+        small.splice( small.cbegin(), --small.cend() );
+        small.splice( small.cend(), small.cbegin(), ++++small.cbegin() );
+        assert( ( small == ls::compact_list<int>{ 2, 3, 4, 5, 1 } ) );
+        small.reverse();
+        assert( ( small == ls::compact_list<int>{ 1, 5, 4, 3, 2 } ) );
+        small.erase( ++small.cbegin(), --small.cend() );
+        assert( ( small == ls::compact_list<int>{ 1, 2 } ) );
+        small.assign( { 9, 8, 7 } );
+        assert( ( small == ls::compact_list<int>{ 9, 8, 7 } ) );
+
+        // Values that own memory are moved, not copied bytewise, when the array grows.
+        ls::compact_list<std::string> words;
+        for ( int i = 0; i < 50; ++i ) words.emplace_back( std::to_string( i ) + std::string( i % 3 ? 30 : 1, '*' ) );
+        words.push_back( words.front() );
+        assert( words.size() == 51 and words.back() == words.front() and *++words.begin() == "1" + std::string( 30, '*' ) );
+        ls::compact_list<std::string> words_copy( words );
+        ls::compact_list<std::string> words_moved( std::move( words ) );
+        assert( words.empty() and words_moved == words_copy );
+        words_moved.clear();
+        assert( words_moved.empty() and words_moved.capacity() > 0 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": compact() and fragmentation().\n";
+
+        // Sorting relinks the nodes, so the scan order no longer follows the addresses.
+        ls::list<int> seq;
+        for ( int i = 0; i < 2000; ++i ) seq.push_back( i * 7919 % 2000 );
+        seq.sort();
+        double before = seq.fragmentation();
+
+        // Incremental: 300 nodes per call, resuming where the last call stopped.
+        auto it = seq.compact( seq.cbegin(), 300 );
+        assert( *it == 300 and seq.size() == 2000 );
+        while ( it != seq.end() ) it = seq.compact( it, 300 );
+        assert( seq.fragmentation() < before );
+
+        seq.compact();
+        int expected = 0;
+        for ( auto i = seq.begin(); i != seq.end(); ++i ) assert( *i == expected++ );
+        assert( expected == 2000 );
+
+        // One call lays the nodes out by increasing address, side by side in the pool.
+        bool forward = true;
+        for ( auto i = seq.begin(), j = ++seq.begin(); j != seq.end(); ++i, ++j )
+            forward = forward and &*i < &*j;
+        assert( forward and seq.fragmentation() == 1.0 );
+
+        ls::list<std::string> words { "alpha", "beta", "gamma" };
+        words.compact();
+        assert( ( words == ls::list<std::string>{ "alpha", "beta", "gamma" } ) );
+        ls::list<int> tiny;
+        tiny.compact();
+        assert( tiny.empty() and tiny.fragmentation() == 0.0 and tiny.compact( tiny.cbegin(), 5 ) == tiny.end() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": stats policy.\n";
+
+        // The default policy adds nothing to the list.
+        static_assert( sizeof( ls::list<int> ) == sizeof( ls::list< int, ls::pool_allocator<int>, ls::no_stats > ) );
+        ls::list<int> plain { 1, 2, 3 };
+        assert( plain.stats().snapshot().allocations == 0 );
+
+        typedef ls::list< int, ls::pool_allocator<int>, ls::counting_stats > counted_list;
+        ls::counting_stats::reset_global();
+        {
+            counted_list seq;
+            for ( int i = 0; i < 10; ++i ) seq.push_back( i );
+            seq.pop_front();
+            assert( seq.find( 7 ) != seq.cend() and seq.find( 42 ) == seq.cend() );
+            seq.erase( seq.end() );
+            seq.advance_to( 5 );
+
+            ls::list_stats_snapshot s = seq.stats().snapshot();
+            assert( s.allocations == 10 and s.frees == 1 );
+            assert( s.finds == 2 and s.find_hits == 1 and s.find_probes == 7 + 9 );
+            assert( s.end_erases == 1 and s.steps == 7 + 9 + 3 ); // advance_to( 5 ) walks back from the tail.
+
+            // Copies count on their own; the process-wide counters see both lists.
+            counted_list copy( seq );
+            assert( copy.stats().snapshot().allocations == 9 and copy.stats().snapshot().finds == 0 );
+            auto it = copy.begin();
+            it + 3;
+            assert( ls::counting_stats::global().allocations == 19 and ls::counting_stats::global().steps == s.steps + 3 );
+        }
+        ls::list_stats_snapshot g = ls::counting_stats::global();
+        assert( g.frees == 19 and g.allocations == 19 );
+        assert( ls::to_json( g ).find( "\"allocations\": 19, \"frees\": 19" ) != std::string::npos );
+
+        // Const lookups on several threads count every call.
+        {
+            const counted_list shared { 1, 2, 3, 4 };
+            std::vector< std::thread > readers;
+            for ( int t = 0; t < 4; ++t )
+                readers.emplace_back( [&shared]{ for ( int i = 0; i < 1000; ++i ) shared.find( 3 ); } );
+            for ( auto & r : readers ) r.join();
+            assert( shared.stats().snapshot().finds == 4000 and shared.stats().snapshot().find_hits == 4000 );
+        }
+        ls::counting_stats::reset_global();
+        assert( ls::counting_stats::global().steps == 0 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": serialize() and deserialize().\n";
+
+        ls::list<int> numbers;
+        for ( int i = 0; i < 100000; ++i ) numbers.push_back( i * 3 - 7 );
+        ls::list<std::string> words { "", "alpha", std::string( 100000, 'x' ), "omega" };
+
+        // Two lists back to back in one stream.
+        std::stringstream stream;
+        ls::serialize( numbers, stream );
+        ls::serialize( words, stream );
+        assert( stream.str().size() > 100000 * sizeof( int ) );
+
+        ls::list<int> numbers_back = ls::deserialize<int>( stream );
+        ls::list<std::string> words_back = ls::deserialize<std::string>( stream );
+        assert( numbers_back == numbers and words_back == words );
+
+        // Appends, and leaves the list alone when the stream is bad.
+        std::stringstream small;
+        ls::serialize( ls::list<int>{ 4, 5 }, small );
+        std::string bytes = small.str();
+        ls::list<int> target { 1, 2, 3 };
+        ls::deserialize( small, target );
+        assert( ( target == ls::list<int>{ 1, 2, 3, 4, 5 } ) );
+
+        std::stringstream truncated( bytes.substr( 0, bytes.size() - 1 ) );
+        bool thrown = false;
+        try { ls::deserialize( truncated, target ); } catch ( const std::runtime_error & ) { thrown = true; }
+        assert( thrown and target.size() == 5 );
+
+        std::stringstream other_type( bytes );
+        thrown = false;
+        try { ls::deserialize<double>( other_type ); } catch ( const std::runtime_error & ) { thrown = true; }
+        assert( thrown );
+
+        // Same size, other kind of element.
+        std::stringstream reals;
+        ls::serialize( ls::list<float>{ 1.5f, -2.0f }, reals );
+        std::string real_bytes = reals.str();
+        thrown = false;
+        try { ls::deserialize<int>( reals ); } catch ( const std::runtime_error & ) { thrown = true; }
+        assert( thrown );
+        std::stringstream as_unsigned( bytes );
+        thrown = false;
+        try { ls::deserialize<unsigned>( as_unsigned ); } catch ( const std::runtime_error & ) { thrown = true; }
+        assert( thrown );
+        std::stringstream as_float( real_bytes );
+        assert( ( ls::deserialize<float>( as_float ) == ls::list<float>{ 1.5f, -2.0f } ) );
+
+        std::stringstream empty_stream;
+        ls::serialize( ls::list<double>(), empty_stream );
+        assert( ls::deserialize<double>( empty_stream ).empty() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": write_text(), read_text() and operator>>.\n";
+
+        // Enough values to cross several 1 MiB blocks, so some are cut between two reads.
+        ls::list<long long> numbers;
+        for ( long long i = 0; i < 300000; ++i ) numbers.push_back( i * 7919 - 1000000000000LL );
+        std::stringstream stream;
+        ls::write_text( stream, numbers, '\n' );
+        ls::list<long long> numbers_back;
+        assert( ls::read_text( stream, numbers_back ) == 300000 );
+        assert( numbers_back == numbers and stream.eof() and not stream.fail() );
+
+        // Shortest round trip form for floating point.
+        const ls::list<double> reals { 0.1, -2.5e-300, 1.0 / 3.0, 12345678.0 };
+        std::ostringstream reals_out;
+        ls::write_text( reals_out, reals );
+        assert( reals_out.str() == "0.1 -2.5e-300 0.3333333333333333 12345678 " );
+        std::istringstream reals_in( reals_out.str() );
+        ls::list<double> reals_back;
+        reals_in >> reals_back;
+        assert( reals_back == reals );
+
+        // operator<< takes a const list, and keeps the stream's formatting.
+        const ls::list<int> small { 1, 2, 3 };
+        std::ostringstream printed, written;
+        printed << small;
+        ls::write_text( written, small );
+        assert( printed.str() == "1 2 3 " and written.str() == printed.str() );
+
+        // Appends; any whitespace separates; other types go through the stream.
+        ls::list<int> target { 1 };
+        std::istringstream mixed( "  2\t3\r\n\n4  " );
+        mixed >> target;
+        assert( ( target == ls::list<int>{ 1, 2, 3, 4 } ) );
+
+        ls::list<std::string> words;
+        std::istringstream words_in( "alpha beta\ngamma" );
+        assert( ls::read_text( words_in, words ) == 3 );
+        assert( ( words == ls::list<std::string>{ "alpha", "beta", "gamma" } ) );
+
+        // A bad or out of range value fails the stream and leaves the list alone.
+        for ( const char * bad : { "5 6 x7 8", "5 6 7x", "99999999999", "-" } )
+        {
+            std::istringstream in( bad );
+            in >> target;
+            assert( in.fail() and target.size() == 4 );
+        }
+
+        std::istringstream nothing( "   " );
+        assert( ls::read_text( nothing, target ) == 0 and not nothing.fail() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": assignment reuses nodes.\n";
+
+        using counted = ls::list<std::string, ls::pool_allocator<std::string>, ls::counting_stats>;
+        counted source { "a", "b", "c", "d", "e" };
+        counted cache { "v", "w", "x", "y", "z" };
+
+        // Allocations and frees since the last call.
+        size_t allocations = 0, frees = 0;
+        auto delta = [&cache, &allocations, &frees]( size_t a, size_t f ){
+            ls::list_stats_snapshot s = cache.stats().snapshot();
+            bool ok = s.allocations - allocations == a and s.frees - frees == f;
+            allocations = s.allocations;
+            frees = s.frees;
+            return ok;
+        };
+        delta( 5, 0 );
+
+        // Same size: every node is overwritten, none allocated or freed.
+        cache = source;
+        assert( cache == source and delta( 0, 0 ) );
+
+        // Larger source: only the shortfall is allocated.
+        source.push_back( "f" );
+        source.push_back( "g" );
+        cache = source;
+        assert( cache == source and cache.size() == 7 and delta( 2, 0 ) );
+
+        // Smaller source: only the excess is freed.
+        cache = { "1", "2", "3" };
+        assert( ( cache == counted{ "1", "2", "3" } ) and delta( 0, 4 ) );
+
+        std::vector<std::string> range { "p", "q", "r", "s" };
+        cache.assign( range.begin(), range.end() );
+        assert( cache.size() == 4 and cache.front() == "p" and cache.back() == "s" and delta( 1, 0 ) );
+
+        cache.assign( { "only" } );
+        assert( cache.size() == 1 and cache.front() == "only" and cache.back() == "only" and delta( 0, 3 ) );
+        cache = std::initializer_list<std::string>();
+        assert( cache.empty() and cache.begin() == cache.end() and delta( 0, 1 ) );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": cow_list shares its chain until an edit.\n";
+
+        ls::list<int> big;
+        for ( int i = 0; i < 1000000; ++i ) big.push_back( i );
+        const int * first = &big.front();
+
+        // Taking the list and copying the handle move no element.
+        ls::cow_list<int> original( std::move( big ) );
+        ls::cow_list<int> copy( original );
+        assert( &original.front() == first and &copy.front() == first );
+        assert( copy.shares( original ) and not original.unique() and copy == original );
+
+        // The first edit clones for the editing handle only.
+        copy.push_back( -1 );
+        assert( not copy.shares( original ) and copy.unique() and original.unique() );
+        assert( &original.front() == first and &copy.front() != first );
+        assert( original.size() == 1000000 and copy.size() == 1000001 and copy.back() == -1 );
+
+        // A sole handle edits in place.
+        original.pop_front();
+        assert( &original.front() != first and original.front() == 1 and original.size() == 999999 );
+
+        // Readers on other threads get their own handle in O(1) while the owner keeps editing.
+        ls::cow_list<int> snapshot( original );
+        std::atomic<long long> sums[ 2 ] = { { 0 }, { 0 } };
+        std::vector< std::thread > readers;
+        for ( int t = 0; t < 2; ++t )
+        {
+            readers.emplace_back( [snapshot, &sums, t]{
+                long long s = 0;
+                for ( auto i = snapshot.begin(); i != snapshot.end(); ++i ) s += *i;
+                sums[ t ] = s;
+            } );
+        }
+        for ( int i = 0; i < 1000; ++i ) original.push_back( i );
+        for ( auto & r : readers ) r.join();
+        long long expected = 999999LL * 1000000 / 2;
+        assert( sums[ 0 ] == expected and sums[ 1 ] == expected );
+        assert( snapshot.size() == 999999 and original.size() == 1000999 );
+
+        // Empty handles hold no chain; clear() lets go without cloning.
+        ls::cow_list<std::string> words { "a", "b" };
+        ls::cow_list<std::string> empty, other( words );
+        assert( empty.empty() and empty.begin() == empty.end() and empty.unique() );
+        other.clear();
+        assert( other.empty() and words.unique() and words.size() == 2 );
+        other = words;
+        other.edit().insert( other.edit().cbegin(), "z" );
+        assert( other.front() == "z" and words.front() == "a" and other != words );
+        words = std::move( other );
+        assert( words.size() == 3 and other.empty() );
+        empty.push_front( "x" );
+        assert( empty.size() == 1 and empty.front() == "x" );
+
+        // A list lent out by edit() is copied, not shared, so later edits through the reference stay out of copies.
+        ls::cow_list<int> owner { 1, 2 };
+        ls::list<int> & lent = owner.edit();
+        ls::cow_list<int> kept( owner );
+        ls::cow_list<int> assigned;
+        assigned = owner;
+        lent.push_back( 3 );
+        assert( not kept.shares( owner ) and kept.size() == 2 and assigned.size() == 2 and owner.size() == 3 );
+        // Another edit through the handle ends the loan: copies share again.
+        owner.push_back( 4 );
+        ls::cow_list<int> shared( owner );
+        assert( shared.shares( owner ) and shared.size() == 4 );
+
+        // A clone is allocated where the chain it copies was, not from the default resource.
+        counting_resource here;
+        {
+            typedef ls::cow_list< int, std::pmr::polymorphic_allocator<int> > pmr_cow;
+            pmr_cow mine( { 1, 2, 3 }, &here );
+            pmr_cow copy( mine );
+            size_t before = here.allocations;
+            copy.push_back( 4 );
+            assert( here.allocations == before + 5 and copy.view().get_allocator().resource() == &here );
+            assert( mine.size() == 3 and copy.size() == 4 );
+        }
+        assert( here.allocations == here.deallocations );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": unrolled_list move assignment across resources.\n";
+
+        counting_resource here, there;
+        {
+            typedef ls::unrolled_list< int, 64, std::pmr::polymorphic_allocator<int> > pmr_unrolled;
+            pmr_unrolled seq( &here ), other( &there );
+            for ( int i = 0; i < 100; ++i ) other.push_back( i );
+            seq.push_back( -1 );
+
+            // Unequal resources: the elements are moved into blocks of seq's resource.
+            seq = std::move( other );
+            assert( seq.size() == 100 and seq.front() == 0 and seq.back() == 99 and other.empty() );
+            assert( seq.get_allocator().resource() == &here );
+            assert( there.allocations == there.deallocations );
+
+            // Same resource: the blocks change hands.
+            pmr_unrolled same( &here );
+            size_t before = here.allocations;
+            same = std::move( seq );
+            assert( same.size() == 100 and here.allocations == before );
+        }
+        assert( here.allocations == here.deallocations and there.allocations == there.deallocations );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": indexed_list move assignment across resources.\n";
+
+        counting_resource here, there;
+        {
+            typedef ls::indexed_list< int, std::pmr::polymorphic_allocator<int> > pmr_indexed;
+            pmr_indexed seq( &here ), other( &there );
+            for ( int i = 0; i < 100; ++i ) other.push_back( i );
+            seq.push_back( -1 );
+
+            // Unequal resources: the elements are moved into nodes of seq's resource.
+            seq = std::move( other );
+            assert( seq.size() == 100 and seq.at( 0 ) == 0 and seq.at( 50 ) == 50 and seq.at( 99 ) == 99 and other.empty() );
+            assert( there.allocations == there.deallocations );
+
+            // Same resource: the nodes change hands.
+            pmr_indexed same( &here );
+            size_t before = here.allocations;
+            same = std::move( seq );
+            assert( same.size() == 100 and same.at( 42 ) == 42 and here.allocations == before );
+        }
+        assert( here.allocations == here.deallocations and there.allocations == there.deallocations );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": indexed_find_list move assignment across resources.\n";
+
+        counting_resource here, there;
+        {
+            typedef std::pmr::polymorphic_allocator<int> pmr_alloc;
+            typedef ls::indexed_find_list< int, ls::identity, std::hash<int>, std::equal_to<int>, pmr_alloc > pmr_find_list;
+            ls::list< int, pmr_alloc > mine( &here ), theirs( &there );
+            mine.push_back( -1 );
+            for ( int i = 0; i < 100; ++i ) theirs.push_back( i );
+
+            // The elements are rebuilt in nodes of here; the index must point at those.
+            pmr_find_list seq( std::move( mine ) ), other( std::move( theirs ) );
+            seq = std::move( other );
+            assert( seq.size() == 100 and not seq.contains( -1 ) and other.empty() );
+            assert( there.allocations == there.deallocations );
+            assert( seq.find( 42 ) != seq.cend() and *seq.find( 42 ) == 42 );
+            assert( seq.erase( 42 ) == 1 and not seq.contains( 42 ) and seq.size() == 99 );
+            other.push_back( 7 );
+            assert( other.contains( 7 ) and not other.contains( 0 ) );
+
+            // Same resource: the nodes and the index change hands, with no allocation.
+            pmr_find_list same{ ls::list< int, pmr_alloc >( &here ) };
+            size_t before = here.allocations;
+            same = std::move( seq );
+            assert( here.allocations == before and same.size() == 99 and seq.empty() );
+            assert( *same.find( 43 ) == 43 and same.erase( 43 ) == 1 and not same.contains( 43 ) );
+            seq.push_back( 43 );
+            assert( seq.contains( 43 ) and seq.size() == 1 );
+        }
+
+        // A copy assignment that throws leaves the list and its index as they were.
+        fragile::armed = false;
+        struct fragile_value { int operator()( const fragile & f ) const { return f.value; } };
+        ls::indexed_find_list< fragile, fragile_value > target { fragile( 1 ), fragile( 2 ) };
+        ls::indexed_find_list< fragile, fragile_value > source { fragile( 3 ), fragile( -4 ) };
+        fragile::armed = true;
+        bool thrown = false;
+        try { target = source; } catch ( int ) { thrown = true; }
+        fragile::armed = false;
+        assert( thrown and target.size() == 2 and target.contains( 1 ) and target.contains( 2 ) and not target.contains( 3 ) );
+        source.erase( -4 );
+        target = source;
+        assert( target.size() == 1 and target.contains( 3 ) and not target.contains( 1 ) );
+        assert( here.allocations == here.deallocations and there.allocations == there.deallocations );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": const advance_to() from several threads.\n";
+
+        ls::list<int> seq;
+        for ( int i = 0; i < 10000; ++i ) seq.push_back( i );
+        seq.advance_to( 5000 );
+
+        // Const lookups only read the finger, so readers may share the list.
+        const ls::list<int> & shared = seq;
+        std::atomic<int> wrong{ 0 };
+        std::vector< std::thread > readers;
+        for ( int t = 0; t < 3; ++t )
+        {
+            readers.emplace_back( [&shared, &wrong, t]{
+                for ( int i = t; i < 10000; i += 7 )
+                    if ( *shared.advance_to( i ) != i ) ++wrong;
+            } );
+        }
+        for ( auto & r : readers ) r.join();
+        assert( wrong == 0 );
+        assert( *seq.advance_to( 5001 ) == 5001 and shared.advance_to( 10000 ) == seq.cend() );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": lru_cache entries heavier than the capacity.\n";
+
+        struct chars
+        {
+            size_t operator()( const int &, const std::string & s ) const { return s.size(); }
+        };
+        ls::lru_cache< int, std::string, chars > cache( 10 );
+        cache.put( 1, "aa" );
+        cache.put( 2, "bb" );
+        cache.put( 3, "cc" );
+
+        // A new key too heavy for the whole cache is rejected; the others stay.
+        cache.put( 4, std::string( 50, 'x' ) );
+        assert( not cache.contains( 4 ) and cache.size() == 3 and cache.weight() == 6 );
+        assert( cache.stats().evictions == 0 );
+
+        // An existing key is dropped rather than kept with its old value.
+        cache.put( 2, std::string( 50, 'x' ) );
+        assert( not cache.contains( 2 ) and cache.contains( 1 ) and cache.contains( 3 ) );
+        assert( cache.size() == 2 and cache.weight() == 4 and cache.stats().evictions == 0 );
+
+        // Exactly the capacity still fits, evicting the rest.
+        cache.put( 5, std::string( 10, 'y' ) );
+        assert( cache.contains( 5 ) and cache.size() == 1 and cache.weight() == 10 and cache.stats().evictions == 2 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": compact_list assignment across resources.\n";
+
+        counting_resource here, there;
+        {
+            typedef ls::compact_list< std::string, std::pmr::polymorphic_allocator<std::string> > pmr_compact;
+            pmr_compact seq( &here ), other( &there );
+            for ( int i = 0; i < 100; ++i ) other.push_back( std::to_string( i ) );
+            other.pop_front();
+            seq.push_back( "old" );
+
+            // Copy: the array comes from seq's own resource, and indices are kept.
+            seq = other;
+            assert( seq == other and seq.get_allocator().resource() == &here );
+            assert( seq[ other.handle_of( other.cbegin() ) ] == "1" );
+
+            // Move, unequal resources: the elements move into seq's array.
+            pmr_compact moved( &here );
+            moved = std::move( other );
+            assert( moved == seq and other.empty() and moved.get_allocator().resource() == &here );
+
+            // Move, same resource: the array changes hands.
+            size_t before = here.allocations;
+            pmr_compact same( &here );
+            same = std::move( moved );
+            assert( same == seq and moved.empty() and here.allocations == before );
+        }
+        assert( here.allocations == here.deallocations and there.allocations == there.deallocations );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": node_pool slots can hold their free list link.\n";
+
+        // 12 bytes aligned on 4: slots are padded to 16 so the link of a free slot is aligned.
+        typedef ls::node_pool< 12, 4 > small_pool;
+        static_assert( small_pool::slot_size == 16 and small_pool::slot_align == alignof( void * ) );
+        std::vector< void * > slots;
+        for ( int i = 0; i < 1000; ++i ) slots.push_back( small_pool::allocate_slot() );
+        for ( void * p : slots ) assert( reinterpret_cast< std::uintptr_t >( p ) % alignof( void * ) == 0 );
+        for ( void * p : slots ) small_pool::deallocate_slot( p );
+        void * again = small_pool::allocate_slot();
+        assert( again == slots.back() );
+        small_pool::deallocate_slot( again );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
+    {
+        std::cout << ">>> Unit teste #" << ++n_unit << ": a static list outlives the thread's pool.\n";
+
+        // Checked again by ~exit_check, once main has returned.
+        for ( int i = 0; i < 100000; ++i ) g_exit_check.seq.push_back( i );
+        assert( g_exit_check.seq.size() == 100000 and g_exit_check.seq.back() == 99999 );
+
+        std::cout << ">>> Passed!\n\n";
+    }
+
     return 0;
 }